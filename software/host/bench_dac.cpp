@@ -0,0 +1,140 @@
+// DAC pitch conversion check and benchmark (make bench).
+//
+// This is appended to the merged sketch, like size_report.cpp. It compares
+// OC::DAC::pitch_to_dac and scaled_pitch_to_dac against the previous versions
+// with divisions (copied below) for random calibrations, every pitch in and
+// beyond the DAC range, every octave offset and every voltage scaling, then
+// times both. Times are wall-clock on the host, relative to the original.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+namespace bench_dac {
+
+static const int kIterations = 20000000;
+
+static double wall_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// The original OC::DAC::pitch_to_dac
+__attribute__((noinline))
+static int32_t reference_pitch_to_dac(const OC::DAC::CalibrationData &calibration, DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset) {
+  pitch += (OC::DAC::kOctaveZero + octave_offset) * 12 << 7;
+
+  CONSTRAIN(pitch, 0, (120 << 7));
+
+  const int32_t octave = pitch / (12 << 7);
+  const int32_t fractional = pitch - octave * (12 << 7);
+
+  int32_t sample = calibration.calibrated_octaves[channel][octave];
+  if (fractional) {
+    int32_t span = calibration.calibrated_octaves[channel][octave + 1] - sample;
+    sample += (fractional * span) / (12 << 7);
+  }
+
+  return sample;
+}
+
+// The original OC::DAC::pitch_to_scaled_voltage_dac
+__attribute__((noinline))
+static int32_t reference_scaled_pitch_to_dac(const OC::DAC::CalibrationData &calibration, DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset, uint8_t voltage_scaling) {
+  pitch += (octave_offset * 12) << 7;
+
+  switch (voltage_scaling) {
+    case VOLTAGE_SCALING_1V_PER_OCT: break;
+    case VOLTAGE_SCALING_CARLOS_ALPHA: pitch = (pitch * 25548) >> 15; break;
+    case VOLTAGE_SCALING_CARLOS_BETA: pitch = (pitch * 20917) >> 15; break;
+    case VOLTAGE_SCALING_CARLOS_GAMMA: pitch = (pitch * 11501) >> 15; break;
+    case VOLTAGE_SCALING_BOHLEN_PIERCE: pitch = (pitch * 25969) >> 14; break;
+    case VOLTAGE_SCALING_QUARTERTONE: pitch = pitch >> 1; break;
+    #ifdef BUCHLA_SUPPORT
+    case VOLTAGE_SCALING_1_2V_PER_OCT: pitch = (pitch * 19661) >> 14; break;
+    case VOLTAGE_SCALING_2V_PER_OCT: pitch = pitch << 1; break;
+    #endif
+    default: break;
+  }
+
+  // The rest is the same as pitch_to_dac without an octave offset
+  return reference_pitch_to_dac(calibration, channel, pitch, 0);
+}
+
+__attribute__((noinline))
+static int32_t pitch_to_dac(DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset) {
+  return OC::DAC::pitch_to_dac(channel, pitch, octave_offset);
+}
+
+// Calibrations with rising, flat, falling and extreme octaves
+static void randomize(OC::DAC::CalibrationData &calibration, int round) {
+  for (int channel = 0; channel < DAC_CHANNEL_LAST; ++channel) {
+    int32_t value = rand() % 4096;
+    for (int octave = 0; octave <= OCTAVES; ++octave) {
+      if (round == 0) value = octave * 6553;
+      else if (round == 1) value = octave ? 65535 : 0;
+      else value += (rand() % 9000) - (round & 1 ? 2000 : 0);
+      calibration.calibrated_octaves[channel][octave] = USAT16(value);
+    }
+  }
+}
+
+static int check(OC::DAC::CalibrationData &calibration) {
+  int errors = 0;
+  for (int round = 0; round < 16; ++round) {
+    randomize(calibration, round);
+    OC::DAC::calibration_data_changed();
+    for (int channel = 0; channel < DAC_CHANNEL_LAST; ++channel) {
+      const DAC_CHANNEL dac_channel = static_cast<DAC_CHANNEL>(channel);
+      for (int octave_offset = -5; octave_offset <= 5; ++octave_offset) {
+        for (int32_t pitch = -(150 << 7); pitch <= (150 << 7); ++pitch) {
+          if (OC::DAC::pitch_to_dac(dac_channel, pitch, octave_offset) != reference_pitch_to_dac(calibration, dac_channel, pitch, octave_offset)) {
+            if (errors++ < 10) printf("pitch_to_dac mismatch: channel %d pitch %d offset %d\n", channel, pitch, octave_offset);
+          }
+        }
+      }
+      for (uint8_t scaling = 0; scaling < VOLTAGE_SCALING_LAST; ++scaling) {
+        OC::DAC::set_scaling(scaling, channel);
+        for (int32_t pitch = -(150 << 7); pitch <= (150 << 7); pitch += 3) {
+          if (OC::DAC::scaled_pitch_to_dac(dac_channel, pitch, 1) != reference_scaled_pitch_to_dac(calibration, dac_channel, pitch, 1, scaling)) {
+            if (errors++ < 10) printf("scaled_pitch_to_dac mismatch: channel %d pitch %d scaling %d\n", channel, pitch, scaling);
+          }
+        }
+        OC::DAC::set_scaling(VOLTAGE_SCALING_1V_PER_OCT, channel);
+      }
+    }
+  }
+  return errors;
+}
+
+template <typename F>
+static double bench(F f) {
+  int32_t sum = 0;
+  double start = wall_ns();
+  for (int i = 0; i < kIterations; ++i)
+    sum += f((i * 37) & 0x3fff);
+  double ns = (wall_ns() - start) / kIterations;
+  if (!sum) printf(" ");
+  return ns;
+}
+
+}; // namespace bench_dac
+
+int main() {
+  using namespace bench_dac;
+  static OC::DAC::CalibrationData calibration;
+  randomize(calibration, 2);
+  OC::DAC::Init(&calibration);
+
+  int errors = check(calibration);
+  printf("DAC pitch: %d mismatches\n", errors);
+
+  randomize(calibration, 2);
+  OC::DAC::calibration_data_changed();
+  double ns_reference = bench([](int32_t pitch) { return reference_pitch_to_dac(calibration, DAC_CHANNEL_B, pitch - (60 << 7), 0); });
+  double ns_slopes = bench([](int32_t pitch) { return pitch_to_dac(DAC_CHANNEL_B, pitch - (60 << 7), 0); });
+  printf("  pitch_to_dac, divisions %6.2f ns/call, slopes %6.2f ns/call %5.2fx\n", ns_reference, ns_slopes, ns_slopes / ns_reference);
+
+  return errors ? 1 : 0;
+}
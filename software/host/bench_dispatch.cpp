@@ -0,0 +1,139 @@
+// Hemisphere applet dispatch benchmark (make bench).
+//
+// Appended to the merged sketch, like bench_gfx.cpp. For each applet, running
+// in both hemispheres, it times a tick of both its controllers two ways: as
+// the Hemisphere Manager used to dispatch them, through a function pointer
+// and then the vtable, on whichever slot the applet is in; and as it does now,
+// through the function pointer into Controller(), called directly (see
+// AppletSlot::Controller()). The rest of the ISR is left out.
+// Times are wall-clock on the host, also given as cycles at F_CPU, like the
+// profiler's.
+
+#include <stdio.h>
+#include <time.h>
+#include <algorithm>
+
+#include "oc_host.h"
+
+namespace bench_dispatch {
+
+static const int kTicks = 50000;
+static const int kRuns = 10;
+static const int kRounds = 4;
+
+static double wall_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+template <typename F>
+static double bench(F f) {
+  double best = 1e12;
+  for (int run = 0; run < kRuns; ++run) {
+    double start = wall_ns();
+    for (int i = 0; i < kTicks; ++i) {
+      ++OC::CORE::ticks;
+      f();
+    }
+    double ns = (wall_ns() - start) / kTicks;
+    if (ns < best) best = ns;
+  }
+  return best;
+}
+
+static double cycles(double ns) {
+  return ns * (F_CPU / 1000000) / 1000;
+}
+
+// The previous dispatch, when Controller() was virtual: the manager called the applet's
+// _Controller() through a function pointer, and that called Controller() through the vtable of the
+// applet in the slot.
+class VirtualController {
+public:
+  virtual void Tick(int hemisphere, bool forwarding) = 0;
+};
+
+template <class AppletClass>
+class AppletVirtualController : public VirtualController {
+public:
+  void Tick(int hemisphere, bool forwarding) {
+    AppletClass *applet = reinterpret_cast<AppletClass *>(hemisphere_applet_arena[hemisphere]);
+    applet->template BaseController<AppletClass>(forwarding);
+  }
+
+  static AppletVirtualController instance;
+};
+
+template <class AppletClass>
+AppletVirtualController<AppletClass> AppletVirtualController<AppletClass>::instance;
+
+// Stands in for the vtable pointer of the applet in each slot
+static VirtualController *slot_vtable[2];
+
+static void VirtualDispatch(bool hemisphere, bool forwarding) {
+  slot_vtable[hemisphere]->Tick(hemisphere, forwarding);
+}
+
+struct DispatchedApplet {
+  int id;
+  const char *name;
+  void (*Start)(bool);
+  void (*Controller)(bool, bool);
+  VirtualController *vtable;
+  void (*VirtualController)(bool, bool);
+};
+
+#undef DECLARE_DECIMATED_APPLET
+#define DECLARE_DECIMATED_APPLET(id, categories, class_name, decimation) \
+{ id, #class_name, class_name ## _Start, class_name ## _Controller, \
+  &AppletVirtualController<class_name>::instance, VirtualDispatch }
+
+static void bench_applets() {
+  static DispatchedApplet applets[] = HEMISPHERE_APPLETS;
+  double total_before = 0;
+  double total_after = 0;
+  printf("  %-20s %16s %16s %13s\n", "ctrl, both slots", "fn ptr+virtual", "direct", "saved");
+  for (const DispatchedApplet &applet : applets) {
+    applet.Start(LEFT_HEMISPHERE);
+    applet.Start(RIGHT_HEMISPHERE);
+    slot_vtable[LEFT_HEMISPHERE] = slot_vtable[RIGHT_HEMISPHERE] = applet.vtable;
+    // Alternating, so that both see the same host noise
+    double before = 1e12;
+    double after = 1e12;
+    for (int round = 0; round < kRounds; ++round) {
+      before = std::min(before, bench([&applet]() {
+        applet.VirtualController(LEFT_HEMISPHERE, false);
+        applet.VirtualController(RIGHT_HEMISPHERE, false);
+      }));
+      after = std::min(after, bench([&applet]() {
+        applet.Controller(LEFT_HEMISPHERE, false);
+        applet.Controller(RIGHT_HEMISPHERE, false);
+      }));
+    }
+    total_before += before;
+    total_after += after;
+    printf("  %3d %-16s %6.1f ns %5.1fc %6.1f ns %5.1fc %6.1f cycles\n", applet.id, applet.name,
+           before, cycles(before), after, cycles(after), cycles(before - after));
+  }
+  const int count = ARRAY_SIZE(applets);
+  const double before = total_before / count;
+  const double after = total_after / count;
+  printf("  %-20s %6.1f ns %5.1fc %6.1f ns %5.1fc %6.1f cycles average\n", "all applets",
+         before, cycles(before), after, cycles(after), cycles(before - after));
+}
+
+}; // namespace bench_dispatch
+
+int main() {
+  using namespace bench_dispatch;
+  OC::random_source.set_fixed_seed(1);
+  host::enable_spin_breaker(true);
+  setup();
+  host::enable_spin_breaker(false);
+  OC::CORE::app_isr_enabled = false;
+
+  printf("Applet dispatch, both hemispheres (host cycles @%luMHz):\n", (unsigned long)(F_CPU / 1000000));
+  bench_applets();
+  return 0;
+}
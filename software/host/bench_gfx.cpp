@@ -0,0 +1,249 @@
+// weegfx benchmark (make bench).
+//
+// This is appended to the merged sketch, like size_report.cpp. It checks the
+// word-wide fills and the glyph blitter in weegfx::Graphics against the
+// previous byte-by-byte versions (copied below) for random rectangles, lines
+// and strings, then times each primitive both ways. Finally it renders every
+// Hemisphere applet's View() in both hemispheres and reports the time for
+// each, after booting the firmware so that the applets have their scales,
+// chords etc. Times are wall-clock on the host, relative to the original.
+//
+// The originals mis-clip text that is partly off-screen and some characters
+// past 'z', so the text checks start within the frame and stay below '{'.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "oc_host.h"
+#include "extern/gfx_font_6x8.h"
+
+namespace bench_gfx {
+
+static const int kIterations = 200000;
+static const int kViewIterations = 2000;
+
+static double wall_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+using weegfx::coord_t;
+static const coord_t kWidth = weegfx::Graphics::kWidth;
+static const coord_t kHeight = weegfx::Graphics::kHeight;
+
+static uint8_t reference_frame[weegfx::Graphics::kFrameSize] __attribute__((aligned(4)));
+static uint8_t frame[weegfx::Graphics::kFrameSize] __attribute__((aligned(4)));
+
+// The original byte-by-byte weegfx primitives
+namespace reference {
+
+enum DrawMode { NORMAL, INVERSE };
+
+template <DrawMode mode>
+__attribute__((noinline))
+static void draw_rect(coord_t x, coord_t y, coord_t w, coord_t h) {
+  if (x + w > kWidth) w = kWidth - x;
+  if (x < 0) { w += x; x = 0; }
+  if (w <= 0) return;
+  if (y + h > kHeight) h = kHeight - y;
+  if (y < 0) { h += y; y = 0; }
+  if (h <= 0) return;
+
+  uint8_t *buf = reference_frame + ((y >> 3) << 7) + x;
+  auto row = [w](uint8_t *dst, uint8_t mask) {
+    for (coord_t n = w; n > 0; --n) {
+      if (mode == NORMAL) *dst++ |= mask;
+      else *dst++ ^= mask;
+    }
+  };
+
+  coord_t remainder = y & 0x7;
+  if (remainder) {
+    remainder = 8 - remainder;
+    uint8_t mask = ~(0xff >> remainder);
+    if (h < remainder) {
+      mask &= (0xff >> (remainder - h));
+      h = 0;
+    } else {
+      h -= remainder;
+    }
+    row(buf, mask);
+    buf += kWidth;
+  }
+  remainder = h & 0x7;
+  h >>= 3;
+  while (h--) {
+    row(buf, 0xff);
+    buf += kWidth;
+  }
+  if (remainder)
+    row(buf, ~(0xff << remainder));
+}
+
+__attribute__((noinline))
+static void drawHLine(coord_t x, coord_t y, coord_t w) {
+  if (x + w > kWidth) w = kWidth - x;
+  if (x < 0) { w += x; x = 0; }
+  if (w <= 0 || y < 0 || y >= kHeight) return;
+  uint8_t *dst = reference_frame + ((y >> 3) << 7) + x;
+  while (w-- > 0)
+    *dst++ |= 0x1 << (y & 0x7);
+}
+
+static void draw_char(char c, coord_t x, coord_t y) {
+  if (!c) c = '0';
+  if (c <= 32 || c > 127)
+    return;
+
+  coord_t w = weegfx::Graphics::kFixedFontW;
+  coord_t h = weegfx::Graphics::kFixedFontH;
+  const uint8_t *data = ssd1306xled_font6x8 + weegfx::Graphics::kFixedFontW * (c - 32);
+  if (x + w > kWidth) w = kWidth - x;
+  if (w <= 0) return;
+  if (y + h > kHeight) h = kHeight - y;
+
+  uint8_t *dest = reference_frame + ((y >> 3) << 7) + x;
+  coord_t remainder = y & 0x7;
+  if (!remainder) {
+    while (w--) *dest++ |= *data++;
+  } else {
+    const uint8_t *src = data;
+    for (coord_t n = w; n--; ) *dest++ |= (*src++) << remainder;
+    if (h >= 8) {
+      dest += kWidth - w;
+      src = data;
+      for (coord_t n = w; n--; ) *dest++ |= (*src++) >> (8 - remainder);
+    }
+  }
+}
+
+__attribute__((noinline))
+static void drawStr(coord_t x, coord_t y, const char *s) {
+  while (*s) {
+    draw_char(*s++, x, y);
+    x += weegfx::Graphics::kFixedFontW;
+  }
+}
+
+}; // namespace reference
+
+static void random_string(char *s, size_t length) {
+  for (size_t i = 0; i < length; ++i)
+    s[i] = 32 + rand() % ('{' - 32);
+  s[length] = '\0';
+}
+
+static int check() {
+  int errors = 0;
+  for (int i = 0; i < 100000; ++i) {
+    memset(reference_frame, 0, sizeof(reference_frame));
+    graphics.Begin(frame, true);
+
+    const int primitive = i % 4;
+    coord_t x = rand() % 160 - 16, y = rand() % 80 - 8;
+    coord_t w = rand() % 140, h = rand() % 72;
+    char s[24];
+    switch (primitive) {
+      case 0:
+        graphics.drawRect(x, y, w, h);
+        reference::draw_rect<reference::NORMAL>(x, y, w, h);
+        break;
+      case 1:
+        memset(frame, 0x5a, sizeof(frame));
+        memset(reference_frame, 0x5a, sizeof(reference_frame));
+        graphics.invertRect(x, y, w, h);
+        reference::draw_rect<reference::INVERSE>(x, y, w, h);
+        break;
+      case 2:
+        graphics.drawHLine(x, y, w);
+        reference::drawHLine(x, y, w);
+        break;
+      case 3:
+        x = rand() % kWidth;
+        y = rand() % kHeight;
+        random_string(s, rand() % 22);
+        graphics.drawStr(x, y, s);
+        reference::drawStr(x, y, s);
+        break;
+    }
+    graphics.End();
+    if (memcmp(frame, reference_frame, sizeof(frame))) {
+      if (errors++ < 10) printf("mismatch: primitive %d x %ld y %ld w %ld h %ld\n", primitive, (long)x, (long)y, (long)w, (long)h);
+    }
+  }
+  return errors;
+}
+
+template <typename F>
+static double bench(F f) {
+  double start = wall_ns();
+  for (int i = 0; i < kIterations; ++i)
+    f(i);
+  return (wall_ns() - start) / kIterations;
+}
+
+static void report(const char *name, double ns_reference, double ns_weegfx) {
+  printf("  %-24s bytes %7.1f ns/call, words %7.1f ns/call %5.2fx\n", name, ns_reference, ns_weegfx, ns_weegfx / ns_reference);
+}
+
+static void bench_primitives() {
+  static const char kText[] = "Hemisphere 120.0";
+  graphics.Begin(frame, true);
+
+  report("drawRect 64x16",
+         bench([](int i) { reference::draw_rect<reference::NORMAL>(i & 0x3f, 8 + (i & 0x7), 64, 16); }),
+         bench([](int i) { graphics.drawRect(i & 0x3f, 8 + (i & 0x7), 64, 16); }));
+  report("invertRect 60x10",
+         bench([](int i) { reference::draw_rect<reference::INVERSE>(i & 0x3f, 8 + (i & 0x7), 60, 10); }),
+         bench([](int i) { graphics.invertRect(i & 0x3f, 8 + (i & 0x7), 60, 10); }));
+  report("drawHLine 62",
+         bench([](int i) { reference::drawHLine(i & 0x3f, i & 0x3f, 62); }),
+         bench([](int i) { graphics.drawHLine(i & 0x3f, i & 0x3f, 62); }));
+  report("drawStr aligned",
+         bench([](int i) { reference::drawStr(i & 0x1f, (i & 0x7) << 3, kText); }),
+         bench([](int i) { graphics.drawStr(i & 0x1f, (i & 0x7) << 3, kText); }));
+  report("drawStr unaligned",
+         bench([](int i) { reference::drawStr(i & 0x1f, 1 + (i % 54), kText); }),
+         bench([](int i) { graphics.drawStr(i & 0x1f, 1 + (i % 54), kText); }));
+
+  graphics.End();
+}
+
+static void bench_views() {
+  static Applet applets[] = HEMISPHERE_APPLETS;
+  double total_ns = 0;
+  for (const Applet &applet : applets) {
+    applet.Start(LEFT_HEMISPHERE);
+    applet.Start(RIGHT_HEMISPHERE);
+    double start = wall_ns();
+    for (int i = 0; i < kViewIterations; ++i) {
+      graphics.Begin(frame, true);
+      applet.View(LEFT_HEMISPHERE);
+      applet.View(RIGHT_HEMISPHERE);
+      graphics.End();
+    }
+    const double ns = (wall_ns() - start) / kViewIterations;
+    total_ns += ns;
+    printf("  view %3d %8.0f ns/frame\n", applet.id, ns);
+  }
+  printf("  views, all applets %8.0f ns/frame average\n", total_ns / ARRAY_SIZE(applets));
+}
+
+}; // namespace bench_gfx
+
+int main() {
+  using namespace bench_gfx;
+  host::enable_spin_breaker(true);
+  setup();
+  host::enable_spin_breaker(false);
+
+  int errors = check();
+  printf("weegfx: %d mismatches\n", errors);
+
+  bench_primitives();
+  bench_views();
+
+  return errors ? 1 : 0;
+}
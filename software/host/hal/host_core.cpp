@@ -0,0 +1,327 @@
+// Virtual time, interval timers and the interrupt scheduler for the host build.
+// See oc_host.h for the time model.
+
+#include <Arduino.h>
+#include <map>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include "oc_host.h"
+
+namespace host {
+
+namespace kinetis {
+#define HOST_DEFINE_REGISTER(name) volatile uint32_t reg_##name;
+HOST_KINETIS_REGISTERS(HOST_DEFINE_REGISTER)
+#undef HOST_DEFINE_REGISTER
+}; // namespace kinetis
+
+static constexpr int kNumTimers = 4; // PIT channels
+
+struct Timer {
+  void (*fn)();
+  uint64_t period_ns;
+  uint64_t next_ns;
+  uint32_t count;
+};
+
+struct Event {
+  EventFn fn;
+  uintptr_t arg;
+};
+
+typedef std::multimap<uint64_t, Event> EventQueue;
+
+static Timer timers[kNumTimers];
+
+// Some firmware globals call millis() from their constructors, so the queue
+// is constructed on first use rather than during static initialization.
+static EventQueue &event_queue() {
+  static EventQueue events;
+  return events;
+}
+
+static uint64_t now_ns_ = 0;
+static uint64_t stop_ns_ = 0;
+static uint64_t isr_entry_wall_ns = 0;
+static uint64_t isr_limit_ns = 0; // Until the next interrupt is due
+
+static uint64_t wall_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Interrupt bookkeeping; these are touched from the SIGALRM handler too.
+static volatile sig_atomic_t isr_depth = 0;
+static volatile sig_atomic_t servicing = 0;
+static volatile sig_atomic_t irq_disabled = 0;
+static volatile uint32_t polls = 0;
+static uint32_t polls_at_last_signal = 0;
+
+static uint64_t next_timer_ns(int *channel) {
+  uint64_t next = UINT64_MAX;
+  for (int i = 0; i < kNumTimers; ++i) {
+    if (timers[i].fn && timers[i].next_ns < next) {
+      next = timers[i].next_ns;
+      *channel = i;
+    }
+  }
+  return next;
+}
+
+// Host events (input edges) are stamped with their exact virtual time. A timer
+// interrupt may spend host time up to the next distinct timer instant.
+static void enter_isr(bool timer) {
+  uint64_t next_ns = UINT64_MAX;
+  for (int i = 0; timer && i < kNumTimers; ++i) {
+    if (timers[i].fn && timers[i].next_ns > now_ns_ && timers[i].next_ns < next_ns)
+      next_ns = timers[i].next_ns;
+  }
+  isr_limit_ns = timer ? next_ns - now_ns_ : 1;
+  isr_entry_wall_ns = wall_ns();
+}
+
+// Advance to and run the next pending interrupt. Host events scheduled at the
+// same time as a timer run first, so e.g. an input edge is visible to the ISR
+// of the same instant.
+static bool service_next(uint64_t limit_ns) {
+  int channel = -1;
+  uint64_t timer_ns = next_timer_ns(&channel);
+  EventQueue &events = event_queue();
+  uint64_t event_ns = events.empty() ? UINT64_MAX : events.begin()->first;
+
+  if (!events.empty() && event_ns <= timer_ns && event_ns <= limit_ns) {
+    Event event = events.begin()->second;
+    events.erase(events.begin());
+    if (event_ns > now_ns_) now_ns_ = event_ns;
+    enter_isr(false);
+    ++isr_depth;
+    event.fn(event.arg);
+    --isr_depth;
+    return true;
+  } else if (channel >= 0 && timer_ns <= limit_ns) {
+    Timer &timer = timers[channel];
+    if (timer_ns > now_ns_) now_ns_ = timer_ns;
+    timer.next_ns += timer.period_ns;
+    ++timer.count;
+    enter_isr(true);
+    ++isr_depth;
+    timer.fn();
+    --isr_depth;
+    return true;
+  }
+  return false;
+}
+
+static void check_stop() {
+  if (stop_ns_ && now_ns_ >= stop_ns_)
+    throw Stop();
+}
+
+static void poll() {
+  if (isr_depth || servicing)
+    return;
+  ++polls;
+  check_stop();
+  if (!irq_disabled) {
+    servicing = 1;
+    service_next(UINT64_MAX);
+    servicing = 0;
+  }
+}
+
+static void wait_ns(uint64_t ns) {
+  if (isr_depth || servicing) {
+    // delay() inside an ISR: just burn virtual time
+    now_ns_ += ns;
+    return;
+  }
+  ++polls;
+  const uint64_t target = now_ns_ + ns;
+  servicing = 1;
+  while (!irq_disabled && service_next(target)) { }
+  if (now_ns_ < target)
+    now_ns_ = target;
+  servicing = 0;
+  check_stop();
+}
+
+static void spin_breaker(int) {
+  if (servicing || isr_depth || irq_disabled)
+    return;
+  if (polls != polls_at_last_signal) {
+    polls_at_last_signal = polls;
+    return;
+  }
+  servicing = 1;
+  service_next(UINT64_MAX);
+  servicing = 0;
+}
+
+void enable_spin_breaker(bool enable) {
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = enable ? spin_breaker : SIG_IGN;
+  sa.sa_flags = SA_RESTART;
+  sigaction(SIGALRM, &sa, nullptr);
+
+  struct itimerval interval;
+  interval.it_interval.tv_sec = 0;
+  interval.it_interval.tv_usec = enable ? 20 : 0;
+  interval.it_value = interval.it_interval;
+  setitimer(ITIMER_REAL, &interval, nullptr);
+}
+
+uint64_t now_us() {
+  return now_ns_ / 1000;
+}
+
+void set_stop_time(uint64_t us) {
+  stop_ns_ = us * 1000;
+}
+
+void run_interrupts(uint64_t us) {
+  const uint64_t target = us * 1000;
+  servicing = 1;
+  while (service_next(target)) { }
+  if (now_ns_ < target)
+    now_ns_ = target;
+  servicing = 0;
+}
+
+uint32_t timer_count(int channel) {
+  return timers[channel].count;
+}
+
+void schedule(uint64_t at_us, EventFn fn, uintptr_t arg) {
+  event_queue().insert(std::make_pair(at_us * 1000, Event{fn, arg}));
+}
+
+bool in_isr() {
+  return isr_depth > 0;
+}
+
+// Inside an interrupt: the virtual time it was due, plus the host time spent
+// in it since. Cycle counts measured within an interrupt are then real host
+// time (as the profiling wants), while timestamps from different interrupts,
+// e.g. of trigger edges and of the ISR that scans them, are their virtual
+// time apart. The host time is capped short of the next timer interrupt, so
+// those stay in order even if the host stalls (see enter_isr). The main loop
+// only measures durations, and gets host time.
+uint32_t cycle_counter() {
+  uint64_t ns = wall_ns();
+  if (isr_depth) {
+    uint64_t spent_ns = ns - isr_entry_wall_ns;
+    if (spent_ns >= isr_limit_ns) spent_ns = isr_limit_ns - 1;
+    ns = now_ns_ + spent_ns;
+  }
+  return (uint32_t)(ns * (F_CPU / 1000000) / 1000);
+}
+
+}; // namespace host
+
+bool IntervalTimer::begin(void (*funct)(), unsigned int microseconds) {
+  end();
+  for (int i = 0; i < host::kNumTimers; ++i) {
+    if (!host::timers[i].fn) {
+      host::Timer &timer = host::timers[i];
+      timer.period_ns = (uint64_t)microseconds * 1000;
+      timer.next_ns = host::now_ns_ + timer.period_ns;
+      timer.count = 0;
+      timer.fn = funct;
+      channel_ = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void IntervalTimer::end() {
+  if (channel_ >= 0) {
+    host::timers[channel_].fn = nullptr;
+    channel_ = -1;
+  }
+}
+
+void IntervalTimer::priority(uint8_t) {
+}
+
+uint32_t millis() {
+  host::poll();
+  return host::now_ns_ / 1000000;
+}
+
+uint32_t micros() {
+  host::poll();
+  return host::now_ns_ / 1000;
+}
+
+void delay(uint32_t ms) {
+  host::wait_ns((uint64_t)ms * 1000000);
+}
+
+void delayMicroseconds(uint32_t usec) {
+  host::wait_ns((uint64_t)usec * 1000);
+}
+
+void yield() {
+  host::poll();
+}
+
+void __disable_irq() {
+  host::irq_disabled = 1;
+}
+
+void __enable_irq() {
+  host::irq_disabled = 0;
+}
+
+static uint32_t random_seed = 1;
+
+void randomSeed(uint32_t seed) {
+  if (seed)
+    random_seed = seed;
+}
+
+static uint32_t random_next() {
+  // Same generator as the Teensy core (Park-Miller via Schrage)
+  int32_t hi, lo, x;
+  x = random_seed;
+  if (x == 0) x = 123459876;
+  hi = x / 127773;
+  lo = x % 127773;
+  x = 16807 * lo - 2836 * hi;
+  if (x < 0) x += 0x7FFFFFFF;
+  random_seed = x;
+  return x;
+}
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return random_next() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+usb_serial_class Serial;
+
+void usb_serial_class::print(const char *s) {
+  fputs(s, stderr);
+}
+
+void usb_serial_class::print(char c) {
+  fputc(c, stderr);
+}
+
+void usb_serial_class::print(long n) {
+  fprintf(stderr, "%ld", n);
+}
+
+void usb_serial_class::print(unsigned long n) {
+  fprintf(stderr, "%lu", n);
+}
@@ -0,0 +1,39 @@
+// Host EEPROM backing store, optionally persisted to a file.
+
+#include <EEPROM.h>
+#include <stdio.h>
+#include <string.h>
+#include "oc_host.h"
+
+EEPROMClass EEPROM;
+
+namespace host {
+
+// Erased EEPROM reads as 0xff
+uint8_t eeprom[E2END + 1];
+EEPROMStats eeprom_stats;
+
+static struct EEPROMInit {
+  EEPROMInit() { memset(eeprom, 0xff, sizeof(eeprom)); }
+} eeprom_init;
+
+void eeprom_load(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (f) {
+    if (fread(eeprom, 1, sizeof(eeprom), f) != sizeof(eeprom))
+      fprintf(stderr, "EEPROM image %s is short\n", path);
+    fclose(f);
+  }
+}
+
+void eeprom_save(const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (f) {
+    fwrite(eeprom, 1, sizeof(eeprom), f);
+    fclose(f);
+  } else {
+    perror(path);
+  }
+}
+
+}; // namespace host
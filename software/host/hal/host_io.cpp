@@ -0,0 +1,309 @@
+// Host GPIO, pin-change interrupts, CV inputs (ADC and ScanDMA) and FreqMeasure.
+
+#include <Arduino.h>
+#include "oc_host.h"
+#include "OC_gpio.h"
+#include "src/drivers/ADC/OC_util_ADC.h"
+#include "src/drivers/ADC/ScanDMA.h"
+#include "src/drivers/FreqMeasure/OC_FreqMeasure.h"
+
+namespace host {
+
+volatile uint8_t pin_levels[CORE_NUM_TOTAL_PINS];
+static uint8_t pin_modes[CORE_NUM_TOTAL_PINS];
+static volatile uint8_t port_output[CORE_NUM_TOTAL_PINS];
+
+struct PinInterrupt {
+  void (*fn)();
+  int mode;
+};
+static PinInterrupt pin_interrupts[CORE_NUM_TOTAL_PINS];
+
+static void freqmeasure_edge();
+static constexpr uint8_t kFreqMeasurePin = 3;
+
+void pin_write(uint8_t pin, uint8_t level) {
+  const uint8_t previous = pin_levels[pin];
+  pin_levels[pin] = level;
+  if (previous == level)
+    return;
+
+  const PinInterrupt &isr = pin_interrupts[pin];
+  const bool falling = !level;
+  if (isr.fn && (isr.mode == CHANGE || (isr.mode == FALLING && falling) || (isr.mode == RISING && !falling)))
+    isr.fn();
+  if (pin == kFreqMeasurePin && falling)
+    freqmeasure_edge();
+}
+
+// Trigger inputs ------------------------------------------------------------
+
+static const uint8_t trigger_pins[4] = { TR1, TR2, TR3, TR4 };
+
+void set_gate(int input, bool high) {
+  // The input stage inverts, so a high gate pulls the pin low
+  pin_write(trigger_pins[input], high ? LOW : HIGH);
+}
+
+static void gate_on(uintptr_t input) { set_gate(input, true); }
+static void gate_off(uintptr_t input) { set_gate(input, false); }
+
+void trigger(uint64_t at_us, int input, uint32_t width_us) {
+  schedule(at_us, gate_on, input);
+  schedule(at_us + width_us, gate_off, input);
+}
+
+void clock(uint64_t start_us, uint64_t end_us, int input, uint32_t period_us, uint32_t width_us) {
+  for (uint64_t t = start_us; t < end_us; t += period_us)
+    trigger(t, input, width_us);
+}
+
+// Panel controls -------------------------------------------------------------
+
+static void pin_low(uintptr_t pin) { pin_write(pin, LOW); }
+static void pin_high(uintptr_t pin) { pin_write(pin, HIGH); }
+
+void press(uint64_t at_us, uint8_t pin, uint32_t duration_us) {
+  schedule(at_us, pin_low, pin);
+  schedule(at_us + duration_us, pin_high, pin);
+}
+
+// One detent: the leading pin goes low, then the other pin falls and both
+// return high. Steps are spaced by 2 UI ticks so the encoder sees each state.
+void turn(uint64_t at_us, uint8_t pin_a, uint8_t pin_b, int clicks) {
+  static constexpr uint32_t kStepUs = 2000;
+  uint8_t first = clicks > 0 ? pin_b : pin_a;
+  uint8_t second = clicks > 0 ? pin_a : pin_b;
+  if (clicks < 0) clicks = -clicks;
+  for (int i = 0; i < clicks; ++i) {
+    schedule(at_us, pin_low, first);
+    schedule(at_us + kStepUs, pin_low, second);
+    schedule(at_us + 2 * kStepUs, pin_high, second);
+    schedule(at_us + 3 * kStepUs, pin_high, first);
+    at_us += 4 * kStepUs;
+  }
+}
+
+// CV inputs ------------------------------------------------------------------
+
+// Nominal front end: 0V reads as 2/3 of full scale (the default calibration
+// offset) and the input is inverted, with ~409.6 counts per volt at 12 bits.
+static constexpr float kAdcZero = 4096.f * 0.6666667f;
+static constexpr float kAdcCountsPerVolt = 4096.f / 10.f;
+
+static uint16_t adc_values[4] = { (uint16_t)kAdcZero, (uint16_t)kAdcZero, (uint16_t)kAdcZero, (uint16_t)kAdcZero };
+static const uint8_t cv_pins[4] = { CV1, CV2, CV3, CV4 };
+
+static void scan_dma_update();
+
+void set_adc_raw(int channel, uint16_t value) {
+  scan_dma_update(); // Conversions up to now saw the previous value
+  adc_values[channel] = value > 4095 ? 4095 : value;
+}
+
+void set_cv(int channel, float volts) {
+  float value = kAdcZero - volts * kAdcCountsPerVolt;
+  if (value < 0.f) value = 0.f;
+  set_adc_raw(channel, (uint16_t)(value + 0.5f));
+}
+
+static uint16_t adc_read_pin(uint8_t pin) {
+  for (int i = 0; i < 4; ++i) {
+    if (cv_pins[i] == pin)
+      return adc_values[i];
+  }
+  return 0;
+}
+
+// FreqMeasure ----------------------------------------------------------------
+
+static constexpr int kFreqMeasureBuffer = 12;
+static bool freqmeasure_active = false;
+static uint64_t freqmeasure_last_us = 0;
+static uint32_t freqmeasure_buffer[kFreqMeasureBuffer];
+static uint8_t freqmeasure_head = 0, freqmeasure_tail = 0;
+
+static void freqmeasure_edge() {
+  if (!freqmeasure_active)
+    return;
+  const uint64_t now = now_us();
+  if (freqmeasure_last_us) {
+    uint8_t head = (freqmeasure_head + 1) % kFreqMeasureBuffer;
+    if (head != freqmeasure_tail) {
+      freqmeasure_buffer[freqmeasure_head] = (uint32_t)((now - freqmeasure_last_us) * (F_BUS / 1000000));
+      freqmeasure_head = head;
+    }
+  }
+  freqmeasure_last_us = now;
+}
+
+}; // namespace host
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  host::pin_modes[pin] = mode;
+  if (mode == INPUT_PULLUP)
+    host::pin_levels[pin] = HIGH;
+  else if (mode == INPUT_PULLDOWN)
+    host::pin_levels[pin] = LOW;
+}
+
+void attachInterrupt(uint8_t pin, void (*function)(void), int mode) {
+  host::pin_interrupts[pin].fn = function;
+  host::pin_interrupts[pin].mode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  host::pin_interrupts[pin].fn = nullptr;
+}
+
+volatile uint8_t *portOutputRegister(uint8_t pin) {
+  return &host::port_output[pin];
+}
+
+// ADC ------------------------------------------------------------------------
+// Only the single-shot conversion and DMA scan paths used by OC::ADC are
+// modelled; results are 16-bit left-aligned like the hardware at
+// kAdcScanResolution.
+
+static volatile uint32_t host_adc_registers[ADC_NUM_ADCS][32];
+static uint8_t host_adc_pin[ADC_NUM_ADCS];
+
+ADC_Module::ADC_Module(uint8_t ADC_number, const uint8_t* const a_channel2sc1a, const ADC_NLIST* const a_diff_table) :
+  fail_flag(0)
+  , ADC_num(ADC_number)
+  , calibrating(0)
+  , init_calib(0)
+  , analog_res_bits(16)
+  , analog_max_val(0xffff)
+  , analog_num_average(0)
+  , analog_reference_internal(0)
+  , var_enableInterrupts(0)
+  , pga_value(1)
+  , conversion_speed(0)
+  , sampling_speed(0)
+  , channel2sc1a(a_channel2sc1a)
+  , diff_table(a_diff_table)
+  , adc_offset(0)
+#define HOST_ADC_REG(name, index) , name(&host_adc_registers[ADC_number][index])
+  HOST_ADC_REG(ADC_SC1A, 0) HOST_ADC_REG(ADC_SC1B, 1) HOST_ADC_REG(ADC_CFG1, 2) HOST_ADC_REG(ADC_CFG2, 3)
+  HOST_ADC_REG(ADC_RA, 4) HOST_ADC_REG(ADC_RB, 5) HOST_ADC_REG(ADC_CV1, 6) HOST_ADC_REG(ADC_CV2, 7)
+  HOST_ADC_REG(ADC_SC2, 8) HOST_ADC_REG(ADC_SC3, 9) HOST_ADC_REG(ADC_PGA, 10) HOST_ADC_REG(ADC_OFS, 11)
+  HOST_ADC_REG(ADC_PG, 12) HOST_ADC_REG(ADC_MG, 13) HOST_ADC_REG(ADC_CLPD, 14) HOST_ADC_REG(ADC_CLPS, 15)
+  HOST_ADC_REG(ADC_CLP4, 16) HOST_ADC_REG(ADC_CLP3, 17) HOST_ADC_REG(ADC_CLP2, 18) HOST_ADC_REG(ADC_CLP1, 19)
+  HOST_ADC_REG(ADC_CLP0, 20) HOST_ADC_REG(ADC_CLMD, 21) HOST_ADC_REG(ADC_CLMS, 22) HOST_ADC_REG(ADC_CLM4, 23)
+  HOST_ADC_REG(ADC_CLM3, 24) HOST_ADC_REG(ADC_CLM2, 25) HOST_ADC_REG(ADC_CLM1, 26) HOST_ADC_REG(ADC_CLM0, 27)
+  HOST_ADC_REG(PDB0_CHnC1, 28)
+#undef HOST_ADC_REG
+  , IRQ_ADC(IRQ_ADC0 + ADC_number)
+{
+}
+
+ADC::ADC() :
+  adc0_obj(0, nullptr, nullptr)
+#if ADC_NUM_ADCS>1
+  , adc1_obj(1, nullptr, nullptr)
+#endif
+  , adc0(&adc0_obj)
+#if ADC_NUM_ADCS>1
+  , adc1(&adc1_obj)
+#endif
+{
+}
+
+void ADC::setReference(uint8_t, int8_t) { }
+void ADC::setResolution(uint8_t, int8_t) { }
+void ADC::setConversionSpeed(uint8_t, int8_t) { }
+void ADC::setSamplingSpeed(uint8_t, int8_t) { }
+void ADC::setAveraging(uint8_t, int8_t) { }
+void ADC::disableInterrupts(int8_t) { }
+void ADC::enableDMA(int8_t) { }
+void ADC::disableDMA(int8_t) { }
+void ADC::disableCompare(int8_t) { }
+
+bool ADC::isComplete(int8_t) {
+  return true;
+}
+
+bool ADC::startSingleRead(uint8_t pin, int8_t adc_num) {
+  host_adc_pin[adc_num > 0 ? adc_num : 0] = pin;
+  return true;
+}
+
+int ADC::readSingle(int8_t adc_num) {
+  return host::adc_read_pin(host_adc_pin[adc_num > 0 ? adc_num : 0]) << 4;
+}
+
+// The scan runs at a fixed conversion rate from Start(), and the ring is
+// brought up to date whenever the firmware asks where the DMA is, or before a
+// CV input changes. 8us per
+// conversion is 16-bit, 4 hardware averages at ~15MHz ADCK, i.e. ~31kHz per
+// CV input.
+namespace host {
+static constexpr uint64_t kScanConversionNs = 8000;
+
+static struct {
+  const uint8_t *pins;
+  size_t num_pins;
+  volatile uint16_t *ring;
+  size_t ring_length;
+  uint64_t start_ns;
+  uint64_t written;
+} scan_dma;
+}; // namespace host
+
+/*static*/ void ScanDMA::Start(::ADC &, const uint8_t *pins, size_t num_pins, volatile uint16_t *ring, size_t ring_length) {
+  host::scan_dma.pins = pins;
+  host::scan_dma.num_pins = num_pins;
+  host::scan_dma.ring = ring;
+  host::scan_dma.ring_length = ring_length;
+  host::scan_dma.start_ns = host::now_us() * 1000;
+  host::scan_dma.written = 0;
+}
+
+namespace host {
+static void scan_dma_update() {
+  auto &scan = scan_dma;
+  if (!scan.ring)
+    return;
+  const uint64_t total = (now_us() * 1000 - scan.start_ns) / kScanConversionNs;
+  if (total - scan.written > scan.ring_length)
+    scan.written = total - scan.ring_length;
+  for (; scan.written < total; ++scan.written)
+    scan.ring[scan.written % scan.ring_length] = adc_read_pin(scan.pins[scan.written % scan.num_pins]) << 4;
+}
+}; // namespace host
+
+/*static*/ size_t ScanDMA::write_index() {
+  host::scan_dma_update();
+  return host::scan_dma.written % host::scan_dma.ring_length;
+}
+
+// FreqMeasure ----------------------------------------------------------------
+
+FreqMeasureClass FreqMeasure;
+
+void FreqMeasureClass::begin() {
+  host::freqmeasure_active = true;
+  host::freqmeasure_last_us = 0;
+  host::freqmeasure_head = host::freqmeasure_tail = 0;
+}
+
+uint8_t FreqMeasureClass::available() {
+  return (host::freqmeasure_head + host::kFreqMeasureBuffer - host::freqmeasure_tail) % host::kFreqMeasureBuffer;
+}
+
+uint32_t FreqMeasureClass::read() {
+  if (host::freqmeasure_head == host::freqmeasure_tail)
+    return 0xFFFFFFFF;
+  uint32_t value = host::freqmeasure_buffer[host::freqmeasure_tail];
+  host::freqmeasure_tail = (host::freqmeasure_tail + 1) % host::kFreqMeasureBuffer;
+  return value;
+}
+
+float FreqMeasureClass::countToFrequency(uint32_t count) {
+  return (float)F_BUS / (float)count;
+}
+
+void FreqMeasureClass::end() {
+  host::freqmeasure_active = false;
+}
@@ -0,0 +1,158 @@
+// Host usbMIDI: a small FIFO of injected messages and a record of sent ones.
+
+#include <Arduino.h>
+#include <string.h>
+#include "oc_host.h"
+
+usb_midi_class usbMIDI;
+
+namespace host {
+static constexpr uint32_t kMidiQueueSize = 64;
+static usb_midi_class::Message midi_queue[kMidiQueueSize];
+static uint64_t midi_queue_us[kMidiQueueSize]; // When each message was injected
+static uint32_t midi_read_ptr = 0;
+static uint32_t midi_write_ptr = 0;
+MidiStats midi_stats;
+}; // namespace host
+
+bool usb_midi_class::read(uint8_t channel) {
+  while (host::midi_read_ptr != host::midi_write_ptr) {
+    const uint32_t index = host::midi_read_ptr++ % host::kMidiQueueSize;
+    current_ = host::midi_queue[index];
+    const uint32_t latency_us = host::now_us() - host::midi_queue_us[index];
+    ++host::midi_stats.reads;
+    if (latency_us > host::midi_stats.max_latency_us)
+      host::midi_stats.max_latency_us = latency_us;
+    if (!channel || current_.type >= SystemExclusive || current_.channel == channel)
+      return true;
+  }
+  return false;
+}
+
+uint32_t usb_midi_class::pending() const {
+  return host::midi_write_ptr - host::midi_read_ptr;
+}
+
+void usb_midi_class::inject(const Message &message) {
+  if (pending() < host::kMidiQueueSize) {
+    host::midi_queue_us[host::midi_write_ptr % host::kMidiQueueSize] = host::now_us();
+    host::midi_queue[host::midi_write_ptr++ % host::kMidiQueueSize] = message;
+  }
+}
+
+static usb_midi_class::Message make_message(uint8_t type, uint8_t data1, uint8_t data2, uint8_t channel) {
+  usb_midi_class::Message message;
+  memset(&message, 0, sizeof(message));
+  message.type = type;
+  message.channel = channel;
+  message.data1 = data1;
+  message.data2 = data2;
+  return message;
+}
+
+void usb_midi_class::inject_note_on(uint8_t note, uint8_t velocity, uint8_t channel) {
+  inject(make_message(NoteOn, note, velocity, channel));
+}
+
+void usb_midi_class::inject_note_off(uint8_t note, uint8_t velocity, uint8_t channel) {
+  inject(make_message(NoteOff, note, velocity, channel));
+}
+
+void usb_midi_class::inject_control_change(uint8_t control, uint8_t value, uint8_t channel) {
+  inject(make_message(ControlChange, control, value, channel));
+}
+
+void usb_midi_class::inject_program_change(uint8_t program, uint8_t channel) {
+  inject(make_message(ProgramChange, program, 0, channel));
+}
+
+void usb_midi_class::inject_sysex(uint32_t length, const uint8_t *data) {
+  Message message = make_message(SystemExclusive, 0, 0, 0);
+  if (length > USB_MIDI_SYSEX_MAX)
+    length = USB_MIDI_SYSEX_MAX;
+  memcpy(message.sysex, data, length);
+  message.sysex_length = length;
+  message.data1 = length & 0x7f;
+  message.data2 = (length >> 7) & 0x7f;
+  inject(message);
+}
+
+void usb_midi_class::inject_realtime(uint8_t type) {
+  inject(make_message(RealTimeSystem, type, 0, 0));
+}
+
+void usb_midi_class::send(uint8_t type, uint8_t data1, uint8_t data2, uint8_t channel) {
+  last_sent_ = make_message(type, data1, data2, channel);
+  ++sent_;
+  if (send_hook_ && type != SystemExclusive)
+    send_hook_(last_sent_);
+}
+
+void usb_midi_class::sendNoteOff(uint8_t note, uint8_t velocity, uint8_t channel) {
+  send(NoteOff, note, velocity, channel);
+}
+
+void usb_midi_class::sendNoteOn(uint8_t note, uint8_t velocity, uint8_t channel) {
+  send(NoteOn, note, velocity, channel);
+}
+
+void usb_midi_class::sendPolyPressure(uint8_t note, uint8_t pressure, uint8_t channel) {
+  send(AfterTouchPoly, note, pressure, channel);
+}
+
+void usb_midi_class::sendControlChange(uint8_t control, uint8_t value, uint8_t channel) {
+  send(ControlChange, control, value, channel);
+}
+
+void usb_midi_class::sendProgramChange(uint8_t program, uint8_t channel) {
+  send(ProgramChange, program, 0, channel);
+}
+
+void usb_midi_class::sendAfterTouch(uint8_t pressure, uint8_t channel) {
+  send(AfterTouchChannel, pressure, 0, channel);
+}
+
+void usb_midi_class::sendPitchBend(int value, uint8_t channel) {
+  value += 8192;
+  send(PitchBend, value & 0x7f, (value >> 7) & 0x7f, channel);
+}
+
+void usb_midi_class::sendSysEx(uint32_t length, const uint8_t *data) {
+  send(SystemExclusive, 0, 0, 0);
+  if (length > USB_MIDI_SYSEX_MAX)
+    length = USB_MIDI_SYSEX_MAX;
+  memcpy(last_sent_.sysex, data, length);
+  last_sent_.sysex_length = length;
+  if (send_hook_)
+    send_hook_(last_sent_);
+}
+
+void usb_midi_class::sendRealTime(uint8_t type) {
+  send(RealTimeSystem, type, 0, 0);
+}
+
+namespace host {
+
+static void midi_event(uintptr_t packed) {
+  usbMIDI.inject(make_message(packed & 0xff, (packed >> 8) & 0xff, (packed >> 16) & 0xff, packed >> 24));
+}
+
+static void schedule_midi(uint64_t at_us, uint8_t type, uint8_t data1, uint8_t data2, uint8_t channel) {
+  schedule(at_us, midi_event, type | (data1 << 8) | (data2 << 16) | ((uintptr_t)channel << 24));
+}
+
+void midi_stream(uint64_t start_us, uint64_t end_us, float bpm, uint8_t channel) {
+  const uint32_t pulse_us = 60000000.f / (bpm * 24);
+  uint32_t pulse = 0;
+  for (uint64_t t = start_us; t < end_us; t += pulse_us, ++pulse) {
+    schedule_midi(t, usb_midi_class::RealTimeSystem, 0, 0, 0);
+    schedule_midi(t, usb_midi_class::ControlChange, 1, pulse & 0x7f, channel);
+    const uint8_t note = 48 + (pulse / 6) % 24;
+    if (pulse % 6 == 0)
+      schedule_midi(t, usb_midi_class::NoteOn, note, 100, channel);
+    if (pulse % 6 == 3)
+      schedule_midi(t, usb_midi_class::NoteOff, note, 0, channel);
+  }
+}
+
+}; // namespace host
@@ -0,0 +1,120 @@
+// Host SPI0 bus model with the two devices on it: the DAC8565 (hardware chip
+// select PCS0 on pin 10) and the SH1106 OLED (GPIO chip select on OLED_CS,
+// data/command on OLED_DC). Transfers complete instantly.
+
+#include <Arduino.h>
+#include <DMAChannel.h>
+#include "oc_host.h"
+#include "OC_gpio.h"
+#include "util/util_SPIFIFO.h"
+
+SPIFIFOclass SPIFIFO;
+host::SPCRemulation SPCR;
+uint8_t SPIFIFOclass::pcs = 0;
+volatile uint8_t *SPIFIFOclass::reg = nullptr;
+
+namespace host {
+
+KinetisSpi SPI0;
+
+static uint32_t spi_bytes_ = 0;
+
+// DAC8565: 24-bit frames of command byte + 16-bit value, framed by CONT
+static uint32_t dac_shift = 0;
+static int dac_bits = 0;
+static uint16_t dac_registers[kDacChannels] = { 0 };
+static uint32_t dac_frames_ = 0;
+
+static void dac_frame(uint32_t frame) {
+  const uint8_t command = frame >> 16;
+  const int channel = (command >> 1) & 0x3;
+  dac_registers[channel] = frame & 0xffff;
+  ++dac_frames_;
+}
+
+// SH1106: page addressing mode only
+static uint8_t oled_ram[kOledPages][kOledColumns];
+static uint8_t oled_page_ = 0;
+static uint8_t oled_column = 0;
+static uint32_t oled_pages_written_ = 0;
+
+static void oled_byte(uint8_t b) {
+  if (pin_levels[OLED_DC] == LOW) {
+    if (b < 0x10) {
+      oled_column = (oled_column & 0xf0) | b;
+    } else if (b < 0x20) {
+      oled_column = (oled_column & 0x0f) | ((b & 0x0f) << 4);
+    } else if ((b & 0xf8) == 0xb0) {
+      oled_page_ = b & 0x07;
+      ++oled_pages_written_;
+    }
+  } else {
+    if (oled_column < kOledColumns)
+      oled_ram[oled_page_][oled_column++] = b;
+  }
+}
+
+void spi_push(uint32_t value) {
+  const bool frame16 = value & SPI_PUSHR_CTAS(1);
+  const uint32_t pcs = (value >> 16) & 0x1f;
+  spi_bytes_ += frame16 ? 2 : 1;
+
+  if (pcs & 0x1) {
+    dac_shift = (dac_shift << (frame16 ? 16 : 8)) | (value & (frame16 ? 0xffff : 0xff));
+    dac_bits += frame16 ? 16 : 8;
+    if (!(value & SPI_PUSHR_CONT)) {
+      if (24 == dac_bits)
+        dac_frame(dac_shift & 0xffffff);
+      dac_shift = 0;
+      dac_bits = 0;
+    }
+  } else if (pin_levels[OLED_CS] == OLED_CS_ACTIVE) {
+    if (frame16)
+      oled_byte(value >> 8);
+    oled_byte(value);
+  }
+}
+
+uint16_t dac_value(int channel) {
+#ifdef BUCHLA_cOC
+  return dac_registers[channel];
+#else
+  return 0xffff - dac_registers[channel];
+#endif
+}
+
+uint32_t dac_frames() {
+  return dac_frames_;
+}
+
+uint32_t spi_bytes() {
+  return spi_bytes_;
+}
+
+const uint8_t *oled_page(int page) {
+  return oled_ram[page];
+}
+
+uint32_t oled_pages_written() {
+  return oled_pages_written_;
+}
+
+void dump_screen(FILE *out, int column_offset) {
+  for (int y = 0; y < kOledPages * 8; ++y) {
+    for (int x = 0; x < 128; ++x) {
+      const uint8_t b = oled_ram[y >> 3][x + column_offset];
+      fputc(b & (1 << (y & 7)) ? '#' : '.', out);
+    }
+    fputc('\n', out);
+  }
+}
+
+}; // namespace host
+
+void DMAChannel::enable() {
+  const uint8_t *src = source_;
+  size_t n = count_ < length_ ? count_ : length_;
+  while (n--)
+    host::spi_push(*src++);
+  complete_ = true;
+}
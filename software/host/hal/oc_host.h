@@ -0,0 +1,85 @@
+// Host-side control of the simulated module: virtual time, the interrupt
+// scheduler, jack/panel inputs and the observable outputs (DAC, OLED RAM).
+//
+// Time model
+// ----------
+// Time is virtual and only moves when the firmware "polls" it: millis(),
+// micros(), delay() and yield() called from the main loop each advance the
+// clock to the next pending interrupt (interval timer or scheduled host event)
+// and run it. The main loop therefore makes one pass per interrupt, and code
+// between polls takes zero module time. Busy-waits that don't poll (e.g.
+// GRAPHICS_BEGIN_FRAME(true)) are broken by a real-time signal that services
+// the next interrupt whenever the main loop hasn't polled recently. With
+// run_interrupts() the timers are serviced back-to-back without a main loop,
+// which is how the ISR benchmark runs the 16666 Hz core tick as fast as the
+// host allows.
+
+#ifndef OC_HOST_H_
+#define OC_HOST_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace host {
+
+// Thrown from a main-loop poll once the stop time has been reached, to unwind
+// out of loop() (which never returns on hardware).
+struct Stop { };
+
+uint64_t now_us();
+void set_stop_time(uint64_t us);
+
+// Service interrupts in timestamp order until virtual time reaches `us`.
+void run_interrupts(uint64_t us);
+// Number of times each interval timer has fired.
+uint32_t timer_count(int channel);
+
+typedef void (*EventFn)(uintptr_t arg);
+void schedule(uint64_t at_us, EventFn fn, uintptr_t arg);
+
+// Enable the real-time fallback that services interrupts while the main loop
+// spins without polling.
+void enable_spin_breaker(bool enable);
+
+bool in_isr();
+
+// Inputs ---------------------------------------------------------------------
+
+// CV inputs 0-3, nominal volts (offset/scale as per default calibration)
+void set_cv(int channel, float volts);
+void set_adc_raw(int channel, uint16_t value);
+
+// Trigger inputs 0-3; jack high == pin low, as per the input buffer
+void set_gate(int input, bool high);
+void trigger(uint64_t at_us, int input, uint32_t width_us = 1000);
+void clock(uint64_t start_us, uint64_t end_us, int input, uint32_t period_us, uint32_t width_us = 1000);
+
+// Panel controls (by pin number as in OC_gpio.h)
+void press(uint64_t at_us, uint8_t pin, uint32_t duration_us);
+void turn(uint64_t at_us, uint8_t pin_a, uint8_t pin_b, int clicks);
+
+// usbMIDI input: 24 ppqn clock with a CC 1 on every pulse, and 16th notes, on
+// `channel` (1-16). See usb_midi.h for the queue latency stats.
+void midi_stream(uint64_t start_us, uint64_t end_us, float bpm, uint8_t channel);
+
+// Outputs --------------------------------------------------------------------
+
+static constexpr int kDacChannels = 4;
+// Value as written by the firmware to OC::DAC (i.e. before output inversion)
+uint16_t dac_value(int channel);
+uint32_t dac_frames();
+uint32_t spi_bytes();
+static constexpr uint32_t kSpiClock = F_BUS / 2; // As set up by SPI_init()
+
+static constexpr int kOledColumns = 132;
+static constexpr int kOledPages = 8;
+const uint8_t *oled_page(int page);
+uint32_t oled_pages_written();
+void dump_screen(FILE *out, int column_offset);
+
+void eeprom_load(const char *path);
+void eeprom_save(const char *path);
+
+}; // namespace host
+
+#endif // OC_HOST_H_
@@ -0,0 +1,298 @@
+#!/usr/bin/env python3
+#
+# Turn the o_c_REV Arduino sketch into a single C++ translation unit, the way
+# the Arduino builder does it:
+#
+# - the main sketch (o_c_REV.ino) comes first, followed by the other .ino
+#   files in alphabetical order;
+# - <Arduino.h> is included at the top;
+# - prototypes are generated for free functions defined at file scope (not in
+#   a namespace or class), and inserted before the first function definition.
+#   A prototype that names a type defined in the sketch itself is deferred
+#   until just after that type's definition;
+# - #line directives map diagnostics back to the original .ino files.
+#
+# Usage: ino2cpp.py <sketch dir> <output.cpp> [--append header.h ...]
+
+import argparse
+import os
+import re
+import sys
+
+KEYWORDS = {'if', 'for', 'while', 'switch', 'return', 'sizeof', 'do', 'else',
+            'case', 'catch', 'new', 'delete'}
+
+
+def blank_noncode(text):
+    """Replace comments, string/char literals and preprocessor lines with
+    spaces, keeping newlines so offsets and line numbers are preserved.
+    Like ctags, only the first branch of #if/#else is kept, so conditional
+    code with unbalanced braces in each branch doesn't upset the scan."""
+    return blank_else_branches(blank_literals(text))
+
+
+def blank_else_branches(code_and_directives):
+    code, directives = code_and_directives
+    out = list(code)
+    skip_depth = 0
+    depth = 0
+    for start, end, directive in directives:
+        word = directive.split()[0] if directive.split() else ''
+        if word in ('if', 'ifdef', 'ifndef'):
+            depth += 1
+        elif word in ('else', 'elif'):
+            if not skip_depth:
+                skip_depth = depth
+                skip_start = end
+        elif word == 'endif':
+            if skip_depth == depth:
+                for j in range(skip_start, start):
+                    if out[j] != '\n':
+                        out[j] = ' '
+                skip_depth = 0
+            depth -= 1
+    return ''.join(out)
+
+
+def blank_literals(text):
+    out = list(text)
+    directives = []
+    i = 0
+    n = len(text)
+    at_line_start = True
+    while i < n:
+        c = text[i]
+        if at_line_start and c == '#':
+            # Preprocessor directive, including continuation lines
+            start = i
+            while i < n and text[i] != '\n':
+                if text[i] == '\\' and i + 1 < n and text[i + 1] == '\n':
+                    out[i] = ' '
+                    i += 2
+                    continue
+                out[i] = ' '
+                i += 1
+            directives.append((start, i, text[start + 1:i].strip()))
+            continue
+        if c == '\n':
+            at_line_start = True
+            i += 1
+            continue
+        if c in ' \t\r':
+            i += 1
+            continue
+        at_line_start = False
+        if text.startswith('//', i):
+            while i < n and text[i] != '\n':
+                out[i] = ' '
+                i += 1
+        elif text.startswith('/*', i):
+            end = text.find('*/', i + 2)
+            end = n if end < 0 else end + 2
+            for j in range(i, end):
+                if text[j] != '\n':
+                    out[j] = ' '
+            i = end
+        elif c == '"' or c == "'":
+            quote = c
+            out[i] = ' '
+            i += 1
+            while i < n and text[i] != quote:
+                if text[i] == '\\':
+                    out[i] = ' '
+                    i += 1
+                if i < n and text[i] != '\n':
+                    out[i] = ' '
+                i += 1
+            if i < n:
+                out[i] = ' '
+                i += 1
+        else:
+            i += 1
+    return ''.join(out), directives
+
+
+FUNCTION_RE = re.compile(
+    r'^(?P<prefix>(?:[\w:<>,\*&\s]+?))\b(?P<name>[A-Za-z_]\w*)\s*\((?P<args>.*)\)\s*(?P<const>const)?\s*$',
+    re.S)
+TYPE_RE = re.compile(r'^(?:typedef\s+)?(?:struct|class|enum|union)\s+(?:class\s+)?(\w+)')
+TYPEDEF_RE = re.compile(r'^typedef\b.*?\b(\w+)\s*(?:\[[^\]]*\]\s*)*$', re.S)
+USING_RE = re.compile(r'^using\s+(\w+)\s*=')
+
+
+def strip_defaults(args):
+    """Remove default argument values from a parameter list."""
+    params = []
+    depth = 0
+    current = ''
+    for c in args:
+        if c in '(<[{':
+            depth += 1
+        elif c in ')>]}':
+            depth -= 1
+        if c == ',' and depth == 0:
+            params.append(current)
+            current = ''
+        else:
+            current += c
+    params.append(current)
+    result = []
+    for p in params:
+        depth = 0
+        for i, c in enumerate(p):
+            if c in '(<[{':
+                depth += 1
+            elif c in ')>]}':
+                depth -= 1
+            elif c == '=' and depth == 0:
+                p = p[:i]
+                break
+        result.append(p.strip())
+    return ', '.join(result)
+
+
+def scan(code):
+    """Find file-scope function definitions and type definitions.
+
+    Returns (functions, types) where functions is a list of
+    (offset, prototype) and types a list of (name, end_offset)."""
+    functions = []
+    types = []
+    depth = 0
+    stmt_start = 0
+    pending_type = None  # (name, depth) for a type whose body is open
+    i = 0
+    n = len(code)
+    while i < n:
+        c = code[i]
+        if c == '{':
+            if depth == 0:
+                header = ' '.join(code[stmt_start:i].split())
+                m = TYPE_RE.match(header)
+                if m and '(' not in header:
+                    pending_type = m.group(1)
+                elif not re.match(r'^(namespace|extern|template|class|struct|enum|union)\b', header) \
+                        and '=' not in re.sub(r'\(.*\)', '', header):
+                    f = FUNCTION_RE.match(header)
+                    if f and f.group('name') not in KEYWORDS and f.group('prefix').strip():
+                        prefix = ' '.join(f.group('prefix').split())
+                        args = strip_defaults(f.group('args'))
+                        proto = '%s %s(%s)%s;' % (prefix, f.group('name'), args,
+                                                  ' const' if f.group('const') else '')
+                        functions.append((stmt_start, proto.replace(' *', ' *').strip()))
+            depth += 1
+        elif c == '}':
+            depth -= 1
+            if depth == 0:
+                if pending_type:
+                    end = code.find(';', i)
+                    types.append((pending_type, end + 1 if end >= 0 else i + 1))
+                    pending_type = None
+                stmt_start = i + 1
+        elif c == ';' and depth == 0:
+            header = ' '.join(code[stmt_start:i].split())
+            m = TYPEDEF_RE.match(header) or USING_RE.match(header)
+            if m:
+                types.append((m.group(1), i + 1))
+            stmt_start = i + 1
+        i += 1
+    # Skip leading whitespace in function offsets so prototypes go before the
+    # return type, not before the blank lines preceding it
+    fixed = []
+    for offset, proto in functions:
+        while offset < n and code[offset].isspace():
+            offset += 1
+        fixed.append((offset, proto))
+    return fixed, types
+
+
+def line_at(text, offset):
+    return text.count('\n', 0, offset) + 1
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('sketch_dir')
+    parser.add_argument('output')
+    parser.add_argument('--append', action='append', default=[])
+    args = parser.parse_args()
+
+    sketch_dir = os.path.abspath(args.sketch_dir)
+    main_ino = os.path.basename(sketch_dir) + '.ino'
+    inos = sorted((f for f in os.listdir(sketch_dir) if f.endswith('.ino') and f != main_ino),
+                  key=lambda s: s.lower())
+    inos.insert(0, main_ino)
+
+    # Merge, remembering where each file starts
+    sources = []
+    for name in inos:
+        path = os.path.join(sketch_dir, name)
+        with open(path) as f:
+            text = f.read()
+        if not text.endswith('\n'):
+            text += '\n'
+        sources.append((path, text))
+
+    merged = ''.join(text for _, text in sources)
+    code = blank_noncode(merged)
+    functions, types = scan(code)
+
+    if not functions:
+        sys.exit('no functions found in sketch')
+
+    # Prototypes already declared are harmless, but skip exact duplicates
+    default_offset = functions[0][0]
+    type_ends = {}
+    for name, end in types:
+        type_ends.setdefault(name, end)
+
+    insertions = {}
+    seen = set()
+    for offset, proto in functions:
+        if proto in seen:
+            continue
+        seen.add(proto)
+        where = default_offset
+        for ident in re.findall(r'\b\w+\b', proto):
+            if ident in type_ends and type_ends[ident] > where:
+                where = type_ends[ident]
+        if where > offset:
+            continue  # type defined after use; definition is its own declaration
+        insertions.setdefault(where, []).append(proto)
+
+    # Emit, with #line directives
+    file_starts = []
+    pos = 0
+    for path, text in sources:
+        file_starts.append((pos, path))
+        pos += len(text)
+
+    def location(offset):
+        path = file_starts[0][1]
+        start = 0
+        for s, p in file_starts:
+            if s <= offset:
+                path, start = p, s
+        return path, line_at(merged, offset) - line_at(merged, start) + 1
+
+    breaks = sorted(set([s for s, _ in file_starts] + list(insertions.keys())))
+    out = ['#include <Arduino.h>\n']
+    for idx, b in enumerate(breaks):
+        end = breaks[idx + 1] if idx + 1 < len(breaks) else len(merged)
+        if b in insertions:
+            out.append('\n'.join(insertions[b]) + '\n')
+        path, line = location(b)
+        out.append('#line %d "%s"\n' % (line, path))
+        out.append(merged[b:end])
+        if end < len(merged) and not merged[b:end].endswith('\n'):
+            out.append('\n')
+
+    for header in args.append:
+        out.append('#include "%s"\n' % os.path.abspath(header))
+
+    with open(args.output, 'w') as f:
+        f.write(''.join(out))
+
+
+if __name__ == '__main__':
+    main()
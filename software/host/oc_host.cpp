@@ -0,0 +1,271 @@
+// Host driver for the o_c_REV firmware.
+//
+// Boots the firmware (setup()) against the host HAL and then either runs the
+// main loop with the interval timers in virtual time, or (--isr-only) just the
+// timer interrupts back-to-back, which measures how fast the host can run the
+// 16666 Hz core tick. See hal/oc_host.h for the time model.
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "oc_host.h"
+#include "OC_apps.h"
+#include "OC_config.h"
+#include "OC_core.h"
+#include "OC_DAC.h"
+#include "OC_debug.h"
+#include "OC_frame_pacing.h"
+#include "OC_midi_input.h"
+#include "OC_random.h"
+#include "HSMIDI.h"
+
+void setup();
+void loop();
+void HEMISPHERE_debug_dump();
+
+namespace OC {
+namespace apps {
+  void set_current_app(int index);
+}; // namespace apps
+}; // namespace OC
+
+static void usage(const char *name) {
+  fprintf(stderr,
+    "Usage: %s [options]\n"
+    "  --seconds S        module time to run after boot (default 10)\n"
+    "  --isr-only         run only the timer ISRs, without the main loop\n"
+    "  --app XY           switch to app with two-letter id XY after boot\n"
+    "  --cv N=VOLTS       set CV input N (1-4)\n"
+    "  --clock N=BPM      clock trigger input N (1-4) at BPM\n"
+    "  --midi CH=BPM      USB MIDI clock at BPM, with notes and CCs on channel CH\n"
+    "  --eeprom FILE      load EEPROM image from FILE and save it back on exit\n"
+    "  --save             save the settings on exit, like a long press in the app menu\n"
+    "  --screen           print the OLED contents on exit\n"
+    "  --seed N           seed for random() and OC::random_source, for repeatable runs\n"
+    "  --sysex FILE       send the SysEx messages in FILE (.syx) to the module after boot\n"
+    "  --profile          print the Hemisphere profiler SysEx dump on exit\n",
+    name);
+}
+
+static double wall_seconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Decode the records of the 'P' SysEx dump (see HSProfiler.h)
+static void print_profile_record(const usb_midi_class::Message &message) {
+  static const char *const kStages[] = { "DISP", "DAC", "ADC" };
+  static const char *const kTypes[] = { "stage", "ctrl", "view" };
+
+  const uint8_t *sysex = message.sysex;
+  if (message.type != usb_midi_class::SystemExclusive || sysex[1] != 0x7d || sysex[2] != 0x62 || sysex[3] != 'P')
+    return;
+
+  PackedData packed;
+  packed.size = 0;
+  for (int i = 4; i < message.sysex_length && sysex[i] != 0xf7; ++i)
+    packed.data[packed.size++] = sysex[i];
+  UnpackedData record = packed.unpack();
+  auto u32 = [&record](int offset) {
+    return (uint32_t)record.data[offset] | (record.data[offset + 1] << 8) |
+           (record.data[offset + 2] << 16) | ((uint32_t)record.data[offset + 3] << 24);
+  };
+
+  const uint8_t type = record.data[0];
+  if (type > 2)
+    return;
+  if (type == 0)
+    printf("profile: %-5s %-5s    ", kTypes[type], kStages[record.data[1] % 3]);
+  else
+    printf("profile: %-5s %c id %3u ", kTypes[type], record.data[1] ? 'R' : 'L', record.data[2]);
+  printf("min %6u avg %6u max %6u |", u32(3), u32(7), u32(11));
+  for (int b = 0; b < debug::HistogramCycles::kBuckets; ++b)
+    printf(" %u", record.data[15 + 2 * b] | (record.data[16 + 2 * b] << 8));
+  printf("\n");
+}
+
+// Inject each F0 ... F7 message of a .syx file into usbMIDI
+static bool inject_sysex_file(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return false;
+  uint8_t message[USB_MIDI_SYSEX_MAX];
+  uint32_t length = 0;
+  int c;
+  while ((c = fgetc(f)) != EOF) {
+    if (c == 0xf0)
+      length = 0;
+    if (length < sizeof(message))
+      message[length++] = c;
+    if (c == 0xf7)
+      usbMIDI.inject_sysex(length, message);
+  }
+  fclose(f);
+  return true;
+}
+
+static bool parse_assignment(const char *arg, int *index, float *value) {
+  const char *eq = strchr(arg, '=');
+  if (!eq) return false;
+  *index = atoi(arg) - 1;
+  *value = atof(eq + 1);
+  return *index >= 0 && *index < 4;
+}
+
+int main(int argc, char **argv) {
+  double seconds = 10.;
+  bool isr_only = false;
+  bool dump_screen = false;
+  bool profile = false;
+  bool save_settings = false;
+  const char *eeprom_path = nullptr;
+  const char *app = nullptr;
+  const char *sysex_path = nullptr;
+  uint32_t clock_period_us[4] = { 0 };
+  int midi_channel = 0;
+  float midi_bpm = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *next = i + 1 < argc ? argv[i + 1] : nullptr;
+    int index;
+    float value;
+    if (!strcmp(arg, "--seconds") && next) {
+      seconds = atof(next); ++i;
+    } else if (!strcmp(arg, "--isr-only")) {
+      isr_only = true;
+    } else if (!strcmp(arg, "--app") && next && strlen(next) == 2) {
+      app = next; ++i;
+    } else if (!strcmp(arg, "--cv") && next && parse_assignment(next, &index, &value)) {
+      host::set_cv(index, value); ++i;
+    } else if (!strcmp(arg, "--clock") && next && parse_assignment(next, &index, &value) && value > 0) {
+      clock_period_us[index] = (uint32_t)(60000000.f / value); ++i;
+    } else if (!strcmp(arg, "--midi") && next && strchr(next, '=')) {
+      midi_channel = atoi(next);
+      midi_bpm = atof(strchr(next, '=') + 1);
+      if (midi_channel < 1 || midi_channel > 16 || midi_bpm <= 0) {
+        usage(argv[0]);
+        return 1;
+      }
+      ++i;
+    } else if (!strcmp(arg, "--eeprom") && next) {
+      eeprom_path = next; ++i;
+    } else if (!strcmp(arg, "--save")) {
+      save_settings = true;
+    } else if (!strcmp(arg, "--screen")) {
+      dump_screen = true;
+    } else if (!strcmp(arg, "--profile")) {
+      profile = true;
+    } else if (!strcmp(arg, "--sysex") && next) {
+      sysex_path = next; ++i;
+    } else if (!strcmp(arg, "--seed") && next) {
+      randomSeed(strtoul(next, nullptr, 0));
+      OC::random_source.set_fixed_seed(strtoul(next, nullptr, 0)); ++i;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (eeprom_path)
+    host::eeprom_load(eeprom_path);
+
+  host::enable_spin_breaker(true);
+  double boot_start = wall_seconds();
+  setup();
+  const uint64_t boot_us = host::now_us();
+  double boot_wall = wall_seconds() - boot_start;
+  const uint32_t boot_eeprom_reads = host::eeprom_stats.reads;
+
+  if (app) {
+    const uint16_t id = (app[0] << 8) | app[1];
+    const int index = OC::apps::index_of(id);
+    if (index < 0) {
+      fprintf(stderr, "Unknown app %s\n", app);
+      return 1;
+    }
+    OC::apps::current_app->HandleAppEvent(OC::APP_EVENT_SUSPEND);
+    OC::apps::set_current_app(index);
+    OC::apps::current_app->HandleAppEvent(OC::APP_EVENT_RESUME);
+  }
+
+  if (sysex_path && !inject_sysex_file(sysex_path)) {
+    fprintf(stderr, "Can't read %s\n", sysex_path);
+    return 1;
+  }
+
+  const uint64_t end_us = boot_us + (uint64_t)(seconds * 1000000.);
+  for (int input = 0; input < 4; ++input) {
+    if (clock_period_us[input])
+      host::clock(boot_us, end_us, input, clock_period_us[input]);
+  }
+  if (midi_bpm > 0)
+    host::midi_stream(boot_us, end_us, midi_bpm, midi_channel);
+  const uint32_t start_ticks = OC::CORE::ticks;
+  const uint32_t start_spi_bytes = host::spi_bytes();
+  const uint32_t start_dac_frames = host::dac_frames();
+  const uint32_t start_oled_pages = host::oled_pages_written();
+  const double start = wall_seconds();
+  if (isr_only) {
+    host::enable_spin_breaker(false);
+    OC::CORE::app_isr_enabled = true;
+    host::run_interrupts(end_us);
+  } else {
+    host::set_stop_time(end_us);
+    try {
+      loop();
+    } catch (const host::Stop &) {
+    }
+    host::enable_spin_breaker(false);
+  }
+  const double wall = wall_seconds() - start;
+  const uint32_t ticks = OC::CORE::ticks - start_ticks;
+  const double module_seconds = (host::now_us() - boot_us) * 1e-6;
+
+  printf("boot: %.3fs module, %.3fs wall, %u EEPROM bytes read\n", boot_us * 1e-6, boot_wall, boot_eeprom_reads);
+  printf("run: %.3fs module, %.3fs wall, %.1fx real time\n", module_seconds, wall, module_seconds / wall);
+  printf("core ticks: %u (%.0f Hz), %.1f ns/tick wall\n", ticks, ticks / module_seconds, wall * 1e9 / (ticks ? ticks : 1));
+  printf("ISR cycles (host, @%luMHz): avg %u min %u max %u\n", (unsigned long)(F_CPU / 1000000),
+         OC::DEBUG::ISR_cycles.value(), OC::DEBUG::ISR_cycles.min_value(), OC::DEBUG::ISR_cycles.max_value());
+  printf("ISR overruns: %u, missed ticks %u\n", OC::DEBUG::ISR_overruns, OC::DEBUG::ISR_missed_ticks);
+  printf("DAC: %u %u %u %u\n", host::dac_value(0), host::dac_value(1), host::dac_value(2), host::dac_value(3));
+  printf("main loop: %u fps (target %u), %u%% idle\n", OC::frame_pacing.fps(), OC::frame_pacing.frame_rate(), OC::frame_pacing.idle_percent());
+  if (midi_bpm > 0)
+    printf("MIDI in: %u messages read, max latency %u us; dispatcher backlog max %u, latency max %u ticks, lost %u\n",
+           host::midi_stats.reads, host::midi_stats.max_latency_us,
+           OC::midi_input.backlog_max(), OC::midi_input.latency_max(), OC::midi_input.lost());
+  printf("SPI: %u bytes, %u DAC frames, %u OLED pages\n", host::spi_bytes(), host::dac_frames(), host::oled_pages_written());
+  // Bus time at the SPI clock, without the gaps between frames
+  const uint32_t run_spi_bytes = host::spi_bytes() - start_spi_bytes;
+  const double spi_us = run_spi_bytes * 8 * 1e6 / host::kSpiClock;
+  printf("SPI run: %.1f%% busy (%.2f us/tick @%uMHz), %.2f DAC frames/tick, %.1f OLED pages/s\n",
+         spi_us * 1e-4 / module_seconds, spi_us / (ticks ? ticks : 1), host::kSpiClock / 1000000,
+         (double)(host::dac_frames() - start_dac_frames) / (ticks ? ticks : 1),
+         (host::oled_pages_written() - start_oled_pages) / module_seconds);
+
+  if (dump_screen)
+    host::dump_screen(stdout, SH1106_128x64_Driver::kDefaultOffset);
+
+  if (profile) {
+    usbMIDI.set_send_hook(print_profile_record);
+    HEMISPHERE_debug_dump();
+    usbMIDI.set_send_hook(nullptr);
+  }
+
+  if (save_settings) {
+    const uint32_t writes = host::eeprom_stats.writes;
+    OC::apps::Save();
+    while (OC::apps::SaveStep()) { }
+    printf("EEPROM: %u bytes written by save\n", host::eeprom_stats.writes - writes);
+  }
+
+  if (eeprom_path)
+    host::eeprom_save(eeprom_path);
+
+  return 0;
+}
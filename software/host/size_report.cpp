@@ -0,0 +1,143 @@
+// RAM budget report for the o_c_REV firmware (make sizes).
+//
+// This is appended to the merged sketch, so every applet and app class is
+// visible. It prints sizeof() for each Hemisphere applet, each app's instance,
+// GlobalSettings and AppData, and fails to compile when one of the budgets
+// below is exceeded.
+//
+// The large const tables, which take flash rather than RAM, have a budget of
+// their own. Their sources are included here, so that their sizes are known;
+// the oc_sizes link leaves out the objects they're usually built into.
+//
+// Sizes are measured on the host (LP64), so classes with pointers (vtables,
+// help text) come out a little larger than on the Teensy. The budgets are
+// therefore slightly conservative.
+
+#include <stdio.h>
+
+#include "peaks_resources.cpp"
+#include "streams_resources.cpp"
+#include "bjorklund.cpp"
+
+// Budgets, in bytes
+#define BUDGET_APPLET HEMISPHERE_APPLET_SLOT_SIZE // Must fit the arena, see hemisphere_config.h
+#define BUDGET_APP 5120
+#define BUDGET_GLOBAL_SETTINGS 1024
+#define BUDGET_APP_DATA 2048
+#define BUDGET_TOTAL 24576 // Applet arena + apps + settings
+#define BUDGET_TABLES 16384 // Const tables, in flash
+
+namespace size_report {
+
+struct Entry {
+  const char *name;
+  size_t size;
+};
+
+constexpr size_t sum(const Entry *entries, size_t count) {
+  size_t total = 0;
+  for (size_t i = 0; i < count; ++i)
+    total += entries[i].size;
+  return total;
+}
+
+constexpr size_t largest(const Entry *entries, size_t count) {
+  size_t size = 0;
+  for (size_t i = 0; i < count; ++i)
+    if (entries[i].size > size) size = entries[i].size;
+  return size;
+}
+
+// Re-use the applet list from hemisphere_config.h
+#undef DECLARE_APPLET
+#undef DECLARE_DECIMATED_APPLET
+#define DECLARE_DECIMATED_APPLET(id, categories, class_name, decimation) { #class_name, sizeof(class_name) }
+#define DECLARE_APPLET(id, categories, class_name) DECLARE_DECIMATED_APPLET(id, categories, class_name, 1)
+
+constexpr Entry applets[] = HEMISPHERE_APPLETS;
+constexpr size_t kNumApplets = sizeof(applets) / sizeof(applets[0]);
+
+#define SIZE_REPORT_ENTRY(instance) { #instance, sizeof(instance) }
+
+// The host build always has HEMISPHERE_PROFILING, which isn't in release
+// builds, so leave the profiler out of the Hemisphere manager
+#ifdef HEMISPHERE_PROFILING
+constexpr size_t kProfilerSize = sizeof(HemisphereProfiler);
+#else
+constexpr size_t kProfilerSize = 0;
+#endif
+
+constexpr Entry apps[] = {
+  { "manager", sizeof(manager) - kProfilerSize },
+  SIZE_REPORT_ENTRY(captain_midi_instance),
+  SIZE_REPORT_ENTRY(TheDarkestTimeline_instance),
+  SIZE_REPORT_ENTRY(EnigmaTMWS_instance),
+  SIZE_REPORT_ENTRY(NeuralNetwork_instance),
+  SIZE_REPORT_ENTRY(scale_editor_instance),
+  SIZE_REPORT_ENTRY(WaveformEditor_instance),
+  SIZE_REPORT_ENTRY(pong_instance),
+  SIZE_REPORT_ENTRY(Backup_instance),
+  SIZE_REPORT_ENTRY(Settings_instance),
+};
+constexpr size_t kNumApps = sizeof(apps) / sizeof(apps[0]);
+
+constexpr Entry settings_data[] = {
+  SIZE_REPORT_ENTRY(OC::GlobalSettings),
+  SIZE_REPORT_ENTRY(OC::AppData),
+};
+
+constexpr Entry tables[] = {
+  SIZE_REPORT_ENTRY(peaks::lut_gravity),
+  SIZE_REPORT_ENTRY(peaks::lut_env_linear),
+  SIZE_REPORT_ENTRY(peaks::lut_env_expo),
+  SIZE_REPORT_ENTRY(peaks::lut_env_quartic),
+  SIZE_REPORT_ENTRY(peaks::lut_env_sine),
+  SIZE_REPORT_ENTRY(peaks::lut_env_plateau),
+  SIZE_REPORT_ENTRY(peaks::lut_env_cliff),
+  SIZE_REPORT_ENTRY(peaks::lut_env_gate),
+  SIZE_REPORT_ENTRY(peaks::lut_env_big_dipper),
+  SIZE_REPORT_ENTRY(peaks::lut_env_medium_dipper),
+  SIZE_REPORT_ENTRY(peaks::lut_env_little_dipper),
+  SIZE_REPORT_ENTRY(peaks::lut_env_sinefold),
+  SIZE_REPORT_ENTRY(peaks::lut_env_increments),
+  SIZE_REPORT_ENTRY(streams::lut_lorenz_rate),
+  SIZE_REPORT_ENTRY(bjorklund_patterns),
+};
+constexpr size_t kNumTables = sizeof(tables) / sizeof(tables[0]);
+
+constexpr size_t kArenaSize = sizeof(hemisphere_applet_arena);
+constexpr size_t kTotal = kArenaSize + sum(apps, kNumApps) + sum(settings_data, 2);
+
+static_assert(largest(applets, kNumApplets) <= BUDGET_APPLET, "Applet over budget, see make sizes");
+static_assert(largest(apps, kNumApps) <= BUDGET_APP, "App over budget, see make sizes");
+static_assert(sizeof(OC::GlobalSettings) <= BUDGET_GLOBAL_SETTINGS, "GlobalSettings over budget, see make sizes");
+static_assert(sizeof(OC::AppData) <= BUDGET_APP_DATA, "AppData over budget, see make sizes");
+static_assert(kTotal <= BUDGET_TOTAL, "Total RAM over budget, see make sizes");
+static_assert(sum(tables, kNumTables) <= BUDGET_TABLES, "Const tables over budget, see make sizes");
+
+static void print(const char *title, const Entry *entries, size_t count, size_t budget) {
+  printf("%s (budget %zu each)\n", title, budget);
+  for (size_t i = 0; i < count; ++i) {
+    printf("  %-32s %6zu %s\n", entries[i].name, entries[i].size,
+           entries[i].size * 10 > budget * 9 ? "(>90% of budget)" : "");
+  }
+  printf("  %-32s %6zu\n\n", "sum", sum(entries, count));
+}
+
+}; // namespace size_report
+
+int main() {
+  using namespace size_report;
+  print("Hemisphere applets", applets, kNumApplets, BUDGET_APPLET);
+  print("Apps", apps, kNumApps, BUDGET_APP);
+  printf("Settings (budget %u, %u)\n", BUDGET_GLOBAL_SETTINGS, BUDGET_APP_DATA);
+  for (const Entry &entry : settings_data)
+    printf("  %-32s %6zu\n", entry.name, entry.size);
+  printf("\n");
+  printf("Applet arena %zu, total %zu of %u budget\n\n", kArenaSize, kTotal, BUDGET_TOTAL);
+  printf("Const tables (budget %u for all)\n", BUDGET_TABLES);
+  for (const Entry &entry : tables)
+    printf("  %-32s %6zu\n", entry.name, entry.size);
+  printf("  %-32s %6zu\n", "sum", sum(tables, kNumTables));
+  return 0;
+}
@@ -0,0 +1,43 @@
+// Host stand-in for the Teensyduino core. Only the parts of the Arduino/Teensy
+// API that the firmware actually uses are provided; everything that touches
+// hardware is routed into the host HAL (see hal/) so that the firmware sources
+// can be compiled and run unmodified on a Linux build machine.
+
+#ifndef HOST_ARDUINO_H_
+#define HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "kinetis.h"
+#include "core_pins.h"
+#include "IntervalTimer.h"
+#include "elapsedMillis.h"
+#include "usb_serial.h"
+#include "usb_midi.h"
+
+#define FASTRUN
+#define DMAMEM
+#define PROGMEM
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// Teensy random() is a 32-bit LCG seeded by randomSeed(). The host version is
+// deterministic too, so runs are repeatable unless the driver reseeds it.
+// random(void) is left to libc.
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(uint32_t seed);
+
+#endif // HOST_ARDUINO_H_
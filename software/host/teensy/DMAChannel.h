@@ -0,0 +1,34 @@
+// Host stand-in for Teensy DMAChannel, sufficient for the SH1106 page
+// transfer: enabling a channel whose destination is SPI0_PUSHR pushes the
+// source buffer through the host SPI model immediately, so the transfer is
+// complete by the time the next ISR calls Flush().
+
+#ifndef HOST_DMACHANNEL_H_
+#define HOST_DMACHANNEL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+class DMAChannel {
+public:
+  DMAChannel() : source_(nullptr), length_(0), count_(0), complete_(false) { }
+
+  void destination(volatile uint8_t &) { }
+  void transferSize(unsigned int) { }
+  void transferCount(unsigned int len) { count_ = len; }
+  void disableOnCompletion() { }
+  void triggerAtHardwareEvent(uint8_t) { }
+  void sourceBuffer(const uint8_t *p, unsigned int len) { source_ = p; length_ = len; }
+  void enable();
+  void disable() { }
+  void clearComplete() { complete_ = false; }
+  bool complete() const { return complete_; }
+
+private:
+  const uint8_t *source_;
+  size_t length_;
+  size_t count_;
+  bool complete_;
+};
+
+#endif // HOST_DMACHANNEL_H_
@@ -0,0 +1,69 @@
+// Host stand-in for the Teensy EEPROM library (EERef/EEPtr/EEPROMClass) on a
+// 2 KiB in-memory array. The driver can load/save the array from a file so
+// settings persist between runs.
+
+#ifndef HOST_EEPROM_H_
+#define HOST_EEPROM_H_
+
+#include <stdint.h>
+
+#define E2END 0x7FF
+
+namespace host {
+extern uint8_t eeprom[E2END + 1];
+struct EEPROMStats {
+  uint32_t reads;
+  uint32_t writes;
+};
+extern EEPROMStats eeprom_stats;
+}; // namespace host
+
+struct EERef {
+  EERef(const int index) : index(index) { }
+
+  uint8_t operator*() const { ++host::eeprom_stats.reads; return host::eeprom[index]; }
+  operator uint8_t() const { return **this; }
+
+  EERef &operator = (const EERef &ref) { return *this = *ref; }
+  EERef &operator = (uint8_t in) { ++host::eeprom_stats.writes; host::eeprom[index] = in; return *this; }
+  EERef &operator += (uint8_t in) { return *this = **this + in; }
+  EERef &operator -= (uint8_t in) { return *this = **this - in; }
+  EERef &operator |= (uint8_t in) { return *this = **this | in; }
+  EERef &operator &= (uint8_t in) { return *this = **this & in; }
+
+  EERef &update(uint8_t in) { return in != *this ? *this = in : *this; }
+
+  int index;
+};
+
+struct EEPtr {
+  EEPtr(const int index) : index(index) { }
+
+  operator int() const { return index; }
+  EEPtr &operator = (int in) { index = in; return *this; }
+
+  bool operator != (const EEPtr &ptr) { return index != ptr.index; }
+  EERef operator*() { return index; }
+
+  EEPtr &operator++() { ++index; return *this; }
+  EEPtr &operator--() { --index; return *this; }
+  EEPtr operator++ (int) { return index++; }
+  EEPtr operator-- (int) { return index--; }
+
+  int index;
+};
+
+struct EEPROMClass {
+  EERef operator[](const int idx) { return idx; }
+  uint8_t read(int idx) { return EERef(idx); }
+  void write(int idx, uint8_t val) { (EERef(idx)) = val; }
+  void update(int idx, uint8_t val) { EERef(idx).update(val); }
+
+  EEPtr begin() { return 0x00; }
+  EEPtr end() { return length(); }
+  uint16_t length() { return E2END + 1; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H_
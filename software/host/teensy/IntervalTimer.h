@@ -0,0 +1,27 @@
+// Host stand-in for Teensy IntervalTimer (PIT channels).
+//
+// Timers are registered with the host scheduler and fire in virtual time; the
+// period is kept in microseconds like the original API.
+
+#ifndef HOST_INTERVALTIMER_H_
+#define HOST_INTERVALTIMER_H_
+
+#include <stdint.h>
+
+class IntervalTimer {
+public:
+  IntervalTimer() : channel_(-1) { }
+  ~IntervalTimer() { end(); }
+
+  bool begin(void (*funct)(), unsigned int microseconds);
+  bool begin(void (*funct)(), int microseconds) { return begin(funct, (unsigned int)microseconds); }
+  bool begin(void (*funct)(), unsigned long microseconds) { return begin(funct, (unsigned int)microseconds); }
+  bool begin(void (*funct)(), long microseconds) { return begin(funct, (unsigned int)microseconds); }
+  void end();
+  void priority(uint8_t n);
+
+private:
+  int channel_;
+};
+
+#endif // HOST_INTERVALTIMER_H_
@@ -0,0 +1,56 @@
+// Host stand-in for Teensy core_pins.h: GPIO, pin interrupts and time.
+//
+// Pins are a flat array of levels. Inputs configured with INPUT_PULLUP idle
+// HIGH, like the hardware; the host driver pulls them low to simulate
+// triggers, buttons and encoder detents. Time is virtual: see hal/host_core.cpp
+// for how millis()/micros()/delay() advance it and service the interval timers.
+
+#ifndef HOST_CORE_PINS_H_
+#define HOST_CORE_PINS_H_
+
+#include <stdint.h>
+
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define INPUT_PULLDOWN 3
+
+#define RISING 3
+#define FALLING 2
+#define CHANGE 4
+
+#define CORE_NUM_TOTAL_PINS 34
+#define LED_BUILTIN 13
+
+namespace host {
+extern volatile uint8_t pin_levels[CORE_NUM_TOTAL_PINS];
+void pin_write(uint8_t pin, uint8_t level);
+}; // namespace host
+
+void pinMode(uint8_t pin, uint8_t mode);
+void attachInterrupt(uint8_t pin, void (*function)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+inline void digitalWrite(uint8_t pin, uint8_t val) {
+  host::pin_write(pin, val ? HIGH : LOW);
+}
+
+inline uint8_t digitalRead(uint8_t pin) {
+  return host::pin_levels[pin];
+}
+
+#define digitalWriteFast(pin, val) digitalWrite((pin), (val))
+#define digitalReadFast(pin) digitalRead(pin)
+
+volatile uint8_t *portOutputRegister(uint8_t pin);
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t usec);
+void yield();
+
+#endif // HOST_CORE_PINS_H_
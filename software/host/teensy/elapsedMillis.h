@@ -0,0 +1,32 @@
+// Host stand-in for Teensy elapsedMillis/elapsedMicros, running on virtual time.
+
+#ifndef HOST_ELAPSEDMILLIS_H_
+#define HOST_ELAPSEDMILLIS_H_
+
+#include "core_pins.h"
+
+class elapsedMillis {
+public:
+  elapsedMillis() : ms_(millis()) { }
+  elapsedMillis(unsigned long val) : ms_(millis() - val) { }
+  operator unsigned long () const { return millis() - ms_; }
+  elapsedMillis &operator = (unsigned long val) { ms_ = millis() - val; return *this; }
+  elapsedMillis &operator -= (unsigned long val) { ms_ += val; return *this; }
+  elapsedMillis &operator += (unsigned long val) { ms_ -= val; return *this; }
+private:
+  unsigned long ms_;
+};
+
+class elapsedMicros {
+public:
+  elapsedMicros() : us_(micros()) { }
+  elapsedMicros(unsigned long val) : us_(micros() - val) { }
+  operator unsigned long () const { return micros() - us_; }
+  elapsedMicros &operator = (unsigned long val) { us_ = micros() - val; return *this; }
+  elapsedMicros &operator -= (unsigned long val) { us_ += val; return *this; }
+  elapsedMicros &operator += (unsigned long val) { us_ -= val; return *this; }
+private:
+  unsigned long us_;
+};
+
+#endif // HOST_ELAPSEDMILLIS_H_
@@ -0,0 +1,168 @@
+// Host stand-ins for the MK20DX256 peripheral registers used by the firmware.
+//
+// Most registers are plain memory cells that simply remember the last value
+// written. The SPI0 status/push/pop registers are proxies: writes to PUSHR are
+// decoded by the host SPI bus model (DAC8565 + SH1106, see hal/host_spi.cpp)
+// and SR always reports an idle, drained FIFO so the busy-waits in
+// util_SPIFIFO.h and the SH1106 driver fall straight through.
+
+#ifndef HOST_KINETIS_H_
+#define HOST_KINETIS_H_
+
+#include <stdint.h>
+
+#ifndef KINETISK
+#define KINETISK
+#endif
+
+#define HOST_KINETIS_REGISTERS(X) \
+  X(SIM_SCGC3) X(SIM_SCGC6) \
+  X(CORE_PIN2_CONFIG) X(CORE_PIN6_CONFIG) X(CORE_PIN9_CONFIG) X(CORE_PIN10_CONFIG) \
+  X(CORE_PIN11_CONFIG) X(CORE_PIN13_CONFIG) X(CORE_PIN15_CONFIG) X(CORE_PIN20_CONFIG) \
+  X(CORE_PIN21_CONFIG) X(CORE_PIN22_CONFIG) X(CORE_PIN23_CONFIG) X(CORE_PIN26_CONFIG) \
+  X(ARM_DEMCR) X(ARM_DWT_CTRL)
+
+namespace host {
+namespace kinetis {
+#define HOST_DECLARE_REGISTER(name) extern volatile uint32_t reg_##name;
+HOST_KINETIS_REGISTERS(HOST_DECLARE_REGISTER)
+#undef HOST_DECLARE_REGISTER
+}; // namespace kinetis
+
+// Free-running CPU cycle counter at F_CPU. Durations measured with it are
+// "host time expressed in F_CPU cycles", useful for relative comparisons
+// only, but inside interrupts it follows virtual time, so timestamps from
+// different interrupts are their virtual time apart (see host_core.cpp).
+uint32_t cycle_counter();
+
+void spi_push(uint32_t value);
+}; // namespace host
+
+#define SIM_SCGC3 host::kinetis::reg_SIM_SCGC3
+#define SIM_SCGC6 host::kinetis::reg_SIM_SCGC6
+#define SIM_SCGC3_ADC1 ((uint32_t)0x08000000)
+#define SIM_SCGC6_ADC0 ((uint32_t)0x08000000)
+#define SIM_SCGC6_SPI0 ((uint32_t)0x00001000)
+
+#define CORE_PIN2_CONFIG host::kinetis::reg_CORE_PIN2_CONFIG
+#define CORE_PIN6_CONFIG host::kinetis::reg_CORE_PIN6_CONFIG
+#define CORE_PIN9_CONFIG host::kinetis::reg_CORE_PIN9_CONFIG
+#define CORE_PIN10_CONFIG host::kinetis::reg_CORE_PIN10_CONFIG
+#define CORE_PIN11_CONFIG host::kinetis::reg_CORE_PIN11_CONFIG
+#define CORE_PIN13_CONFIG host::kinetis::reg_CORE_PIN13_CONFIG
+#define CORE_PIN15_CONFIG host::kinetis::reg_CORE_PIN15_CONFIG
+#define CORE_PIN20_CONFIG host::kinetis::reg_CORE_PIN20_CONFIG
+#define CORE_PIN21_CONFIG host::kinetis::reg_CORE_PIN21_CONFIG
+#define CORE_PIN22_CONFIG host::kinetis::reg_CORE_PIN22_CONFIG
+#define CORE_PIN23_CONFIG host::kinetis::reg_CORE_PIN23_CONFIG
+#define CORE_PIN26_CONFIG host::kinetis::reg_CORE_PIN26_CONFIG
+#define PORT_PCR_MUX(n) ((uint32_t)(((n) & 7) << 8))
+#define PORT_PCR_DSE ((uint32_t)0x00000040)
+
+#define ARM_DEMCR host::kinetis::reg_ARM_DEMCR
+#define ARM_DEMCR_TRCENA (1 << 24)
+#define ARM_DWT_CTRL host::kinetis::reg_ARM_DWT_CTRL
+#define ARM_DWT_CTRL_CYCCNTENA (1 << 0)
+#define ARM_DWT_CYCCNT (host::cycle_counter())
+
+// SPI0 (DSPI) register bits
+#define SPI_MCR_MSTR ((uint32_t)0x80000000)
+#define SPI_MCR_CONT_SCKE ((uint32_t)0x40000000)
+#define SPI_MCR_PCSIS(n) (((n) & 0x1F) << 16)
+#define SPI_MCR_MDIS ((uint32_t)0x00004000)
+#define SPI_MCR_CLR_TXF ((uint32_t)0x00000800)
+#define SPI_MCR_CLR_RXF ((uint32_t)0x00000400)
+#define SPI_MCR_HALT ((uint32_t)0x00000001)
+#define SPI_CTAR_DBR ((uint32_t)0x80000000)
+#define SPI_CTAR_FMSZ(n) (((n) & 15) << 27)
+#define SPI_CTAR_CPOL ((uint32_t)0x04000000)
+#define SPI_CTAR_CPHA ((uint32_t)0x02000000)
+#define SPI_CTAR_PBR(n) (((n) & 3) << 16)
+#define SPI_CTAR_BR(n) (((n) & 15) << 0)
+#define SPI_SR_TCF ((uint32_t)0x80000000)
+#define SPI_SR_EOQF ((uint32_t)0x10000000)
+#define SPI_RSER_TFFF_RE ((uint32_t)0x02000000)
+#define SPI_RSER_TFFF_DIRS ((uint32_t)0x01000000)
+#define SPI_RSER_RFDF_RE ((uint32_t)0x00020000)
+#define SPI_RSER_RFDF_DIRS ((uint32_t)0x00010000)
+#define SPI_PUSHR_CONT ((uint32_t)0x80000000)
+#define SPI_PUSHR_CTAS(n) (((n) & 7) << 28)
+#define SPI_PUSHR_EOQ ((uint32_t)0x08000000)
+#define SPI_PUSHR_PCS(n) (((n) & 31) << 16)
+
+namespace host {
+
+// Transfers complete instantaneously: TCF and EOQF set, one word in the RX
+// FIFO and an empty TX FIFO.
+struct SpiStatusRegister {
+  static constexpr uint32_t kIdle = SPI_SR_TCF | SPI_SR_EOQF | (1 << 4);
+  operator uint32_t() const { return kIdle; }
+  SpiStatusRegister &operator = (uint32_t) { return *this; }
+};
+
+struct SpiPushRegister {
+  operator uint32_t() const { return 0; }
+  SpiPushRegister &operator = (uint32_t value) { spi_push(value); return *this; }
+};
+
+struct SpiPopRegister {
+  operator uint32_t() const { return 0; }
+};
+
+struct KinetisSpi {
+  volatile uint32_t MCR;
+  volatile uint32_t TCR;
+  volatile uint32_t CTAR0;
+  volatile uint32_t CTAR1;
+  SpiStatusRegister SR;
+  volatile uint32_t RSER;
+  SpiPushRegister PUSHR;
+  SpiPopRegister POPR;
+};
+
+extern KinetisSpi SPI0;
+
+// Teensyduino's AVR SPCR emulation; only used to route the SPI pins
+struct SPCRemulation {
+  void enable_pins() { }
+};
+}; // namespace host
+
+extern host::SPCRemulation SPCR;
+
+#define KINETISK_SPI0 host::SPI0
+#define SPI0_MCR KINETISK_SPI0.MCR
+#define SPI0_TCR KINETISK_SPI0.TCR
+#define SPI0_CTAR0 KINETISK_SPI0.CTAR0
+#define SPI0_CTAR1 KINETISK_SPI0.CTAR1
+#define SPI0_SR KINETISK_SPI0.SR
+#define SPI0_RSER KINETISK_SPI0.RSER
+#define SPI0_PUSHR KINETISK_SPI0.PUSHR
+#define SPI0_POPR ((uint32_t)KINETISK_SPI0.POPR)
+
+#define DMAMUX_SOURCE_SPI0_TX 17
+
+// Interrupt controller; priorities are recorded but the host scheduler runs
+// handlers strictly in timestamp order.
+enum IRQ_NUMBER_t {
+  IRQ_ADC0 = 39,
+  IRQ_ADC1 = 73,
+  IRQ_PIT_CH0 = 68,
+  IRQ_PIT_CH1 = 69,
+  IRQ_PIT_CH2 = 70,
+  IRQ_PIT_CH3 = 71,
+  IRQ_PORTA = 87,
+  IRQ_PORTB = 88,
+  IRQ_PORTC = 89,
+  IRQ_PORTD = 90,
+  IRQ_PORTE = 91,
+};
+
+#define NVIC_SET_PRIORITY(irqnum, priority) do { (void)(irqnum); (void)(priority); } while (0)
+#define NVIC_ENABLE_IRQ(n) do { (void)(n); } while (0)
+#define NVIC_DISABLE_IRQ(n) do { (void)(n); } while (0)
+
+void __disable_irq();
+void __enable_irq();
+
+#endif // HOST_KINETIS_H_
@@ -0,0 +1,86 @@
+// Host stand-in for the Teensy usbMIDI object (pre-1.42 API, as used by the
+// firmware). Incoming messages are queued by the host driver with inject_*();
+// outgoing messages are recorded so tests and the driver can inspect them.
+
+#ifndef HOST_USB_MIDI_H_
+#define HOST_USB_MIDI_H_
+
+#include <stdint.h>
+
+#define USB_MIDI_SYSEX_MAX 290
+
+namespace host {
+// Messages read by the firmware, and the longest they waited in the queue
+struct MidiStats {
+  uint32_t reads;
+  uint32_t max_latency_us;
+};
+extern MidiStats midi_stats;
+}; // namespace host
+
+class usb_midi_class {
+public:
+  // Message type codes returned by getType()
+  static constexpr uint8_t NoteOff = 0;
+  static constexpr uint8_t NoteOn = 1;
+  static constexpr uint8_t AfterTouchPoly = 2;
+  static constexpr uint8_t ControlChange = 3;
+  static constexpr uint8_t ProgramChange = 4;
+  static constexpr uint8_t AfterTouchChannel = 5;
+  static constexpr uint8_t PitchBend = 6;
+  static constexpr uint8_t SystemExclusive = 7;
+  static constexpr uint8_t RealTimeSystem = 8;
+
+  struct Message {
+    uint8_t type;
+    uint8_t channel; // 1-16
+    uint8_t data1;
+    uint8_t data2;
+    uint16_t sysex_length;
+    uint8_t sysex[USB_MIDI_SYSEX_MAX];
+  };
+
+  bool read(uint8_t channel = 0);
+  uint8_t getType() const { return current_.type; }
+  uint8_t getChannel() const { return current_.channel; }
+  uint8_t getData1() const { return current_.data1; }
+  uint8_t getData2() const { return current_.data2; }
+  uint8_t *getSysExArray() { return current_.sysex; }
+  uint16_t getSysExArrayLength() const { return current_.sysex_length; }
+
+  void sendNoteOff(uint8_t note, uint8_t velocity, uint8_t channel);
+  void sendNoteOn(uint8_t note, uint8_t velocity, uint8_t channel);
+  void sendPolyPressure(uint8_t note, uint8_t pressure, uint8_t channel);
+  void sendControlChange(uint8_t control, uint8_t value, uint8_t channel);
+  void sendProgramChange(uint8_t program, uint8_t channel);
+  void sendAfterTouch(uint8_t pressure, uint8_t channel);
+  void sendPitchBend(int value, uint8_t channel);
+  void sendSysEx(uint32_t length, const uint8_t *data);
+  void sendRealTime(uint8_t type);
+  void send_now() { }
+
+  // Host side
+  void inject(const Message &message);
+  void inject_note_on(uint8_t note, uint8_t velocity, uint8_t channel);
+  void inject_note_off(uint8_t note, uint8_t velocity, uint8_t channel);
+  void inject_control_change(uint8_t control, uint8_t value, uint8_t channel);
+  void inject_program_change(uint8_t program, uint8_t channel);
+  void inject_sysex(uint32_t length, const uint8_t *data);
+  void inject_realtime(uint8_t type);
+  uint32_t pending() const;
+  uint32_t sent() const { return sent_; }
+  const Message &last_sent() const { return last_sent_; }
+  // Called for every sent message
+  void set_send_hook(void (*hook)(const Message &)) { send_hook_ = hook; }
+
+private:
+  Message current_;
+  Message last_sent_;
+  uint32_t sent_;
+  void (*send_hook_)(const Message &);
+  void send(uint8_t type, uint8_t data1, uint8_t data2, uint8_t channel);
+};
+
+extern usb_midi_class usbMIDI;
+
+#endif // HOST_USB_MIDI_H_
@@ -0,0 +1,27 @@
+// Host stand-in for the Teensy USB serial port; output goes to stderr.
+
+#ifndef HOST_USB_SERIAL_H_
+#define HOST_USB_SERIAL_H_
+
+#include <stdint.h>
+
+class usb_serial_class {
+public:
+  void begin(long) { }
+  int available() { return 0; }
+  int read() { return -1; }
+  void flush() { }
+  void print(const char *s);
+  void print(char c);
+  void print(long n);
+  void print(unsigned long n);
+  void print(int n) { print((long)n); }
+  void print(unsigned n) { print((unsigned long)n); }
+  void println() { print('\n'); }
+  template <typename T> void println(T t) { print(t); println(); }
+  operator bool() const { return true; }
+};
+
+extern usb_serial_class Serial;
+
+#endif // HOST_USB_SERIAL_H_
@@ -76,7 +76,8 @@ public:
         }
     }
     
-    void OnReceiveSysEx() {
+    // The ISR only listens, so each packet goes straight to EEPROM and nothing is left pending
+    bool OnReceiveSysEx() {
         uint8_t V[33];
         if (ExtractSysExData(V, 'B')) {
             uint8_t ix = 0;
@@ -91,6 +92,7 @@ public:
                 OC::apps::Init(0);
             }
         }
+        return false;
     }
         
 private:
@@ -146,7 +148,9 @@ size_t Backup_restore(const void *storage) {return 0;}
 void Backup_handleAppEvent(OC::AppEvent event) {
     if (event == OC::APP_EVENT_RESUME) Backup_instance.Resume();
 }
-void Backup_loop() {} // Deprecated
+void Backup_loop() {
+    Backup_instance.ProcessSysEx();
+}
 void Backup_screensaver() {Backup_instance.View();}
 void Backup_handleEncoderEvent(const UI::Event &event) {
     Backup_instance.ToggleCalibration();
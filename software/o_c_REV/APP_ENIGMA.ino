@@ -119,22 +119,24 @@ public:
         SendSong();
     }
 
-    void OnReceiveSysEx() {
-        byte V[48];
-        if (ExtractSysExData(V, 'T')) {
-            char type = V[0]; // Type of Enigma data:r=Register, s=Song step, c=Song Config, 1=single TM
-            if (type == 'r') ReceiveTuringMachine(V);
-            if (type == 's') ReceiveSongSteps(V);
-            if (type == 't') ReceiveTrackSettings(V);
-            if (type == 'o') ReceiveOutputAssignments(V);
-            if (type == '1') {
-                // Receive if the current occupant is not a Favorite
-                if (mode == ENIGMA_MODE_LIBRARY) V[1] = tm_cursor;
-                if (!HS::user_turing_machines[V[1]].favorite) {
-                    ReceiveTuringMachine(V);
-                    HS::user_turing_machines[V[1]].favorite = 0; // Favorite off, so that update may be automated in performance
-                    SwitchTuringMachine(V[1]);
-                }
+    bool OnReceiveSysEx() {
+        return ExtractSysExData(received_data, 'T');
+    }
+
+    void OnApplySysEx() {
+        byte *V = received_data;
+        char type = V[0]; // Type of Enigma data:r=Register, s=Song step, c=Song Config, 1=single TM
+        if (type == 'r') ReceiveTuringMachine(V);
+        if (type == 's') ReceiveSongSteps(V);
+        if (type == 't') ReceiveTrackSettings(V);
+        if (type == 'o') ReceiveOutputAssignments(V);
+        if (type == '1') {
+            // Receive if the current occupant is not a Favorite
+            if (mode == ENIGMA_MODE_LIBRARY) V[1] = tm_cursor;
+            if (!HS::user_turing_machines[V[1]].favorite) {
+                ReceiveTuringMachine(V);
+                HS::user_turing_machines[V[1]].favorite = 0; // Favorite off, so that update may be automated in performance
+                SwitchTuringMachine(V[1]);
             }
         }
     }
@@ -301,6 +303,7 @@ private:
     EnigmaStep song_step[400]; // Max 99 steps per track
     EnigmaOutput output[4];
     EnigmaTrack track[4];
+    byte received_data[48]; // Unpacked by OnReceiveSysEx(), for OnApplySysEx()
 
     //////// NAVIGATION
     byte mode = 0; // 0=Library 1=Assign 2=Song
@@ -1198,7 +1201,9 @@ void EnigmaTMWS_handleAppEvent(OC::AppEvent event) {
     }
 }
 
-void EnigmaTMWS_loop() {} // Deprecated
+void EnigmaTMWS_loop() {
+    EnigmaTMWS_instance.ProcessSysEx();
+}
 
 void EnigmaTMWS_menu() {
     EnigmaTMWS_instance.BaseView();
@@ -30,18 +30,30 @@ namespace menu = OC::menu;
 #include "HSicons.h"
 #include "HSMIDI.h"
 #include "HSClockManager.h"
+#include "HSProfiler.h"
 
-#define DECLARE_APPLET(id, categories, class_name) \
-{ id, categories, class_name ## _Start, class_name ## _Controller, class_name ## _View, \
+#define DECLARE_DECIMATED_APPLET(id, categories, class_name, decimation) \
+{ id, categories, decimation, #class_name, class_name ## _Start, class_name ## _Controller, class_name ## _View, \
   class_name ## _OnButtonPress, class_name ## _OnEncoderMove, class_name ## _ToggleHelpScreen, \
   class_name ## _OnDataRequest, class_name ## _OnDataReceive \
 }
+#define DECLARE_APPLET(id, categories, class_name) DECLARE_DECIMATED_APPLET(id, categories, class_name, 1)
 
 #define HEMISPHERE_DOUBLE_CLICK_TIME 8000
 
+// Preset bank: the applets and data of both hemispheres can be stored in HEMISPHERE_PRESETS
+// presets, and recalled from the preset page, by CV or by MIDI program change. The settings
+// list below has to match the number of presets.
+#define HEMISPHERE_PRESETS 8
+#define HEMISPHERE_PRESET_LINES 5 // Presets shown on the preset page
+#define HEMISPHERE_PRESET_CV_STEP (HEMISPHERE_3V_CV / 6) // 0.5V per preset
+#define HEMISPHERE_MIDI_PROGRAM_CHANGE 4
+
 typedef struct Applet {
   int id;
   uint8_t categories;
+  uint8_t decimation; // Control-rate work every n ticks (power of 2); see HemisphereApplet::ControlTick()
+  const char *name; // Class name, for the preset page
   void (*Start)(bool); // Initialize when selected
   void (*Controller)(bool, bool);  // Interrupt Service Routine
   void (*View)(bool);  // Draw main view
@@ -52,7 +64,10 @@ typedef struct Applet {
   void (*OnDataReceive)(bool, uint32_t); // Send a data int to the applet
 } Applet;
 
-// The settings specify the selected applets, and 32 bits of data for each applet
+// The settings specify the selected applets, and 32 bits of data for each applet. Each preset
+// follows with the same six values (see preset_setting()); an applet ID of 0 is an empty preset.
+// The high 16 bits of the clock's data come after the presets, so that settings saved before
+// either was added still restore.
 enum HEMISPHERE_SETTINGS {
     HEMISPHERE_SELECTED_LEFT_ID,
     HEMISPHERE_SELECTED_RIGHT_ID,
@@ -60,10 +75,21 @@ enum HEMISPHERE_SETTINGS {
     HEMISPHERE_RIGHT_DATA_L,
     HEMISPHERE_LEFT_DATA_H,
     HEMISPHERE_RIGHT_DATA_H,
-    HEMISPHERE_CLOCK_DATA,
+    HEMISPHERE_CLOCK_DATA, // Low 16 bits
+    HEMISPHERE_PRESET_CV, // CV input that selects presets, or 0 for none
+    HEMISPHERE_BUS_ROUTES, // Bus sources of each input; see BusRoutes()
+    HEMISPHERE_PRESETS_START,
+    HEMISPHERE_PRESET_SIZE = HEMISPHERE_CLOCK_DATA,
+    HEMISPHERE_CLOCK_DATA_H = HEMISPHERE_PRESETS_START + HEMISPHERE_PRESETS * HEMISPHERE_PRESET_SIZE,
     HEMISPHERE_SETTING_LAST
 };
 
+// A stored preset, looked up and checked ahead of time so that recalling it is just a swap
+typedef struct HemispherePreset {
+    int8_t applet[2]; // Indexes to available_applets, or -1 if the preset is empty
+    uint32_t data[2];
+} HemispherePreset;
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Hemisphere Manager
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,13 +99,22 @@ class HemisphereManager : public SystemExclusiveHandler,
 public:
     void Init() {
         select_mode = -1; // Not selecting
-        midi_in_hemisphere = -1; // No MIDI In
         Applet applets[] = HEMISPHERE_APPLETS;
         memcpy(&available_applets, &applets, sizeof(applets));
+#ifdef HEMISPHERE_PROFILING
+        for (int i = 0; i < HEMISPHERE_AVAILABLE_APPLETS; i++) profiler.Init(i, available_applets[i].id);
+#endif
         ClockSetup = DECLARE_APPLET(9999, 0x01, ClockSetup);
 
         help_hemisphere = -1;
         clock_setup = 0;
+        preset_page = 0;
+        preset_cursor = 0;
+        pending_preset = -1;
+        cv_preset = -1;
+        combo_release = 0;
+        PreparePresets();
+        SetBusRoutes(0);
 
         SetApplet(0, get_applet_index_by_id(8)); // ADSR
         SetApplet(1, get_applet_index_by_id(26)); // Scale Duet
@@ -93,15 +128,25 @@ public:
             uint32_t data = (values_[4 + h] << 16) + values_[2 + h];
             available_applets[index].OnDataReceive(h, data);
         }
-        ClockSetup.OnDataReceive(0, uint32_t(values_[HEMISPHERE_CLOCK_DATA]));
+        ClockSetup.OnDataReceive(0, (values_[HEMISPHERE_CLOCK_DATA_H] << 16) + values_[HEMISPHERE_CLOCK_DATA]);
+        SetBusRoutes(values_[HEMISPHERE_BUS_ROUTES]);
+        PreparePresets();
+        cv_preset = -1;
     }
 
+    // Select an applet from loop(), with its settings from when it was last selected
     void SetApplet(int hemisphere, int index) {
-        my_applet[hemisphere] = index;
-        if (midi_in_hemisphere == hemisphere) midi_in_hemisphere = -1;
-        if (available_applets[index].id & 0x80) midi_in_hemisphere = hemisphere;
-        available_applets[index].Start(hemisphere);
-        apply_value(hemisphere, available_applets[index].id);
+        // The new applet is constructed over the old one in the arena, so keep the ISR away from
+        // the slot until it's ready
+        bool app_isr_enabled = OC::CORE::app_isr_enabled;
+        OC::CORE::app_isr_enabled = false;
+
+        StartApplet(hemisphere, index);
+        if (snapshot_saved[hemisphere][index]) {
+            available_applets[index].OnDataReceive(hemisphere, applet_snapshot[hemisphere][index]);
+        }
+
+        OC::CORE::app_isr_enabled = app_isr_enabled;
     }
 
     void ChangeApplet(int dir) {
@@ -116,36 +161,46 @@ public:
     }
 
     void ExecuteControllers() {
-        if (midi_in_hemisphere == -1) {
-            // Only one ISR can look for MIDI messages at a time, so we need to check
-            // for another MIDI In applet before looking for sysex. Note that applets
-            // that use MIDI In should check for sysex themselves; see Midi In for an
-            // example.
-            if (usbMIDI.read() && usbMIDI.getType() == 7) {
-                OnReceiveSysEx();
-            }
-        }
+        if (values_[HEMISPHERE_PRESET_CV]) SelectPresetByCV();
+
+        ListenForSysEx();
 
+        clock_m->Tick();
         if (clock_setup) ClockSetup.Controller(LEFT_HEMISPHERE, clock_m->IsForwarded());
 
-        for (int h = 0; h < 2; h++)
+        // A hemisphere that takes inputs from the bus runs after the one that feeds it, so it sees
+        // this tick's outputs. If both take inputs from the bus, the left one sees the right one's
+        // outputs from the previous tick.
+        int first = (BusFed(LEFT_HEMISPHERE) && !BusFed(RIGHT_HEMISPHERE)) ? RIGHT_HEMISPHERE : LEFT_HEMISPHERE;
+        for (int n = 0; n < 2; n++)
         {
+            int h = first ^ n;
+            LatchBusClocks(h);
             int index = my_applet[h];
+            uint32_t mask = available_applets[index].decimation - 1;
+            HemisphereApplet::control_tick[h] = ((OC::CORE::ticks - control_phase[h]) & mask) == 0;
+            HEMISPHERE_PROFILE_SCOPE(h, index, CONTROLLER);
             available_applets[index].Controller(h, clock_m->IsForwarded());
         }
     }
 
     void DrawViews() {
-        if (clock_setup) {
+        if (preset_page) {
+            DrawPresets();
+        } else if (clock_setup) {
             ClockSetup.View(LEFT_HEMISPHERE);
         } else if (help_hemisphere > -1) {
             int index = my_applet[help_hemisphere];
+            HEMISPHERE_PROFILE_SCOPE(help_hemisphere, index, VIEW);
             available_applets[index].View(help_hemisphere);
         } else {
             for (int h = 0; h < 2; h++)
             {
                 int index = my_applet[h];
-                available_applets[index].View(h);
+                {
+                    HEMISPHERE_PROFILE_SCOPE(h, index, VIEW);
+                    available_applets[index].View(h);
+                }
                 if (h == 0) {
                     if (clock_m->IsRunning() || clock_m->IsPaused()) {
                         // Metronome icon
@@ -164,7 +219,15 @@ public:
 
     void DelegateEncoderPush(const UI::Event &event) {
         int h = (event.control == OC::CONTROL_BUTTON_L) ? LEFT_HEMISPHERE : RIGHT_HEMISPHERE;
-        if (clock_setup) {
+        if (preset_page) {
+            if (event.type != UI::EVENT_BUTTON_PRESS) return;
+            if (h == LEFT_HEMISPHERE) {
+                StorePreset(preset_cursor);
+            } else {
+                RecallPreset(preset_cursor);
+                preset_page = 0;
+            }
+        } else if (clock_setup) {
             ClockSetup.OnButtonPress(LEFT_HEMISPHERE);
         } else if (select_mode == h) {
             select_mode = -1; // Pushing a button for the selected side turns off select mode
@@ -177,6 +240,11 @@ public:
     }
 
     void DelegateSelectButtonPush(int hemisphere) {
+        if (preset_page) {
+            preset_page = 0;
+            return;
+        }
+
         if (OC::CORE::ticks - click_tick < HEMISPHERE_DOUBLE_CLICK_TIME && hemisphere == first_click) {
             // This is a double-click, so activate corresponding help screen, leave
             // Select Mode, and reset the double-click timer
@@ -203,7 +271,14 @@ public:
 
     void DelegateEncoderMovement(const UI::Event &event) {
         int h = (event.control == OC::CONTROL_ENCODER_L) ? LEFT_HEMISPHERE : RIGHT_HEMISPHERE;
-        if (clock_setup) {
+        if (preset_page) {
+            if (h == LEFT_HEMISPHERE) {
+                change_value(HEMISPHERE_PRESET_CV, event.value);
+                cv_preset = -1;
+            } else {
+                preset_cursor = constrain(preset_cursor + event.value, 0, HEMISPHERE_PRESETS - 1);
+            }
+        } else if (clock_setup) {
             ClockSetup.OnEncoderMove(LEFT_HEMISPHERE, event.value);
         } else if (select_mode == h) {
             ChangeApplet(event.value);
@@ -221,6 +296,79 @@ public:
 
     void ToggleClockSetup() {
         clock_setup = 1 - clock_setup;
+        preset_page = 0;
+    }
+
+    // Pressing both select buttons toggles the preset page. The combination shows up as the release
+    // of one while the other is held, and the release of the other is then ignored.
+    bool HandlePresetCombo(const UI::Event &event) {
+        const uint16_t select_buttons = OC::CONTROL_BUTTON_UP | OC::CONTROL_BUTTON_DOWN;
+        if (!(event.control & select_buttons)) return false;
+
+        if (event.control & combo_release) {
+            combo_release = 0;
+            return true;
+        }
+
+        if (event.mask & select_buttons & ~event.control) {
+            combo_release = select_buttons & ~event.control;
+            if (!preset_page) {
+                SetHelpScreen(-1);
+                select_mode = -1;
+                clock_setup = 0;
+            }
+            preset_page = 1 - preset_page;
+            return true;
+        }
+        return false;
+    }
+
+    // Store the current applets and their data in a preset. The ISR is held off so that it never
+    // sees a half-written preset.
+    void StorePreset(int preset) {
+        bool app_isr_enabled = OC::CORE::app_isr_enabled;
+        OC::CORE::app_isr_enabled = false;
+
+        HemispherePreset &p = presets[preset];
+        for (int h = 0; h < 2; h++)
+        {
+            int index = my_applet[h];
+            uint32_t data = available_applets[index].OnDataRequest(h);
+            apply_value(preset_setting(preset, HEMISPHERE_SELECTED_LEFT_ID + h), available_applets[index].id);
+            apply_value(preset_setting(preset, HEMISPHERE_LEFT_DATA_L + h), data & 0xffff);
+            apply_value(preset_setting(preset, HEMISPHERE_LEFT_DATA_H + h), (data >> 16) & 0xffff);
+            p.applet[h] = index;
+            p.data[h] = data;
+        }
+
+        OC::CORE::app_isr_enabled = app_isr_enabled;
+    }
+
+    // Recall a preset. The swap itself is done by LoadPendingPreset(), like a preset picked by CV or
+    // program change in the ISR.
+    void RecallPreset(int preset) {
+        if (presets[preset].applet[0] > -1) pending_preset = preset;
+    }
+
+    // Swap in the pending preset, if there is one. This is called from loop(), between UI events, and
+    // the ISR is held off while the applets are constructed in their slots, as in SetApplet().
+    void LoadPendingPreset() {
+        if (pending_preset < 0) return;
+
+        bool app_isr_enabled = OC::CORE::app_isr_enabled;
+        OC::CORE::app_isr_enabled = false;
+
+        LoadPreset(presets[pending_preset]);
+        pending_preset = -1;
+
+        OC::CORE::app_isr_enabled = app_isr_enabled;
+    }
+
+    void OnOtherMIDI(const OC::MidiEvent &event) {
+        if (event.type == HEMISPHERE_MIDI_PROGRAM_CHANGE) {
+            int preset = event.data1;
+            if (preset < HEMISPHERE_PRESETS && presets[preset].applet[0] > -1) pending_preset = preset;
+        }
     }
 
     void SetHelpScreen(int hemisphere) {
@@ -245,7 +393,10 @@ public:
             apply_value(2 + h, data & 0xffff);
             apply_value(4 + h, (data >> 16) & 0xffff);
         }
-        apply_value(HEMISPHERE_CLOCK_DATA, ClockSetup.OnDataRequest(0));
+        uint32_t clock_data = ClockSetup.OnDataRequest(0);
+        apply_value(HEMISPHERE_CLOCK_DATA, clock_data & 0xffff);
+        apply_value(HEMISPHERE_CLOCK_DATA_H, (clock_data >> 16) & 0xffff);
+        apply_value(HEMISPHERE_BUS_ROUTES, BusRoutes());
     }
 
     void OnSendSysEx() {
@@ -272,37 +423,177 @@ public:
         SendSysEx(packed, 'H');
     }
 
-    void OnReceiveSysEx() {
+    // The received applets are looked up here, and swapped in by OnApplySysEx() like a preset
+    bool OnReceiveSysEx() {
         uint8_t V[10];
         if (ExtractSysExData(V, 'H')) {
-            values_[HEMISPHERE_SELECTED_LEFT_ID] = V[0];
-            values_[HEMISPHERE_SELECTED_RIGHT_ID] = V[1];
-            values_[HEMISPHERE_LEFT_DATA_L] = ((uint16_t)V[3] << 8) + V[2];
-            values_[HEMISPHERE_RIGHT_DATA_L] = ((uint16_t)V[5] << 8) + V[4];
-            values_[HEMISPHERE_LEFT_DATA_H] = ((uint16_t)V[7] << 8) + V[6];
-            values_[HEMISPHERE_RIGHT_DATA_H] = ((uint16_t)V[9] << 8) + V[8];
-            Resume();
+            for (int h = 0; h < 2; h++)
+            {
+                uint16_t low = ((uint16_t)V[3 + h * 2] << 8) + V[2 + h * 2];
+                uint16_t high = ((uint16_t)V[7 + h * 2] << 8) + V[6 + h * 2];
+                received_preset.applet[h] = get_applet_index_by_id(V[h]);
+                received_preset.data[h] = ((uint32_t)high << 16) + low;
+            }
+            return true;
         }
+        return false;
     }
 
+    void OnApplySysEx() {
+        LoadPreset(received_preset);
+    }
+
+    int applet_index(int hemisphere) {
+        return my_applet[hemisphere];
+    }
+
+    int applet_id(int index) {
+        return available_applets[index].id;
+    }
+
+#ifdef HEMISPHERE_PROFILING
+    HemisphereProfiler profiler;
+#endif
+
 private:
     Applet available_applets[HEMISPHERE_AVAILABLE_APPLETS];
     Applet ClockSetup;
     int my_applet[2]; // Indexes to available_applets
+    bool slot_in_use[2]; // Has an applet been constructed in the hemisphere's arena slot?
+    uint32_t applet_snapshot[2][HEMISPHERE_AVAILABLE_APPLETS]; // OnDataRequest() of replaced applets
+    bool snapshot_saved[2][HEMISPHERE_AVAILABLE_APPLETS];
     int select_mode;
     bool clock_setup;
+    bool preset_page;
+    int preset_cursor;
+    volatile int pending_preset; // Preset for LoadPendingPreset() to recall, or -1
+    int cv_preset; // Preset last selected by CV, or -1
+    uint16_t combo_release; // Select button whose release ends the preset page combination
+    HemispherePreset presets[HEMISPHERE_PRESETS];
+    HemispherePreset received_preset; // From OnReceiveSysEx(), for OnApplySysEx()
     int help_hemisphere; // Which of the hemispheres (if any) is in help mode, or -1 if none
-    int midi_in_hemisphere; // Which of the hemispheres (if any) is using MIDI In
     uint32_t click_tick; // Measure time between clicks for double-click
     int first_click; // The first button pushed of a double-click set, to see if the same one is pressed
     ClockManager *clock_m = clock_m->get();
+    uint32_t control_phase[2]; // Tick offset of each hemisphere's control-rate slot
+
+    // Decimated applets do their control-rate work when ticks - phase is a multiple of their
+    // decimation. With power-of-2 factors, putting the right hemisphere half of the smaller
+    // factor out of phase means that the two slots can never land on the same tick.
+    void ScheduleControlTicks() {
+        uint8_t left = available_applets[my_applet[LEFT_HEMISPHERE]].decimation;
+        uint8_t right = available_applets[my_applet[RIGHT_HEMISPHERE]].decimation;
+        control_phase[LEFT_HEMISPHERE] = 0;
+        control_phase[RIGHT_HEMISPHERE] = (left < right ? left : right) >> 1;
+        HemisphereApplet::control_decimation[LEFT_HEMISPHERE] = left;
+        HemisphereApplet::control_decimation[RIGHT_HEMISPHERE] = right;
+    }
 
     void DrawClockSetup() {
 
     }
 
+    static int preset_setting(int preset, int value) {
+        return HEMISPHERE_PRESETS_START + preset * HEMISPHERE_PRESET_SIZE + value;
+    }
+
+    // Look up the applets of the stored presets. A preset is only recallable if both applets exist.
+    void PreparePresets() {
+        for (int preset = 0; preset < HEMISPHERE_PRESETS; preset++)
+        {
+            HemispherePreset &p = presets[preset];
+            for (int h = 0; h < 2; h++)
+            {
+                int id = values_[preset_setting(preset, HEMISPHERE_SELECTED_LEFT_ID + h)];
+                p.applet[h] = find_applet_index(id);
+                p.data[h] = (values_[preset_setting(preset, HEMISPHERE_LEFT_DATA_H + h)] << 16)
+                    + values_[preset_setting(preset, HEMISPHERE_LEFT_DATA_L + h)];
+            }
+            if (p.applet[0] < 0 || p.applet[1] < 0) p.applet[0] = p.applet[1] = -1;
+        }
+    }
+
+    // Replace the applet in the hemisphere's slot, keeping the data of the one that's leaving as its
+    // snapshot. The new applet is left with the settings from its Start().
+    void StartApplet(int hemisphere, int index) {
+        if (slot_in_use[hemisphere]) {
+            int previous = my_applet[hemisphere];
+            applet_snapshot[hemisphere][previous] = available_applets[previous].OnDataRequest(hemisphere);
+            snapshot_saved[hemisphere][previous] = 1;
+        }
+
+        my_applet[hemisphere] = index;
+        ScheduleControlTicks();
+        available_applets[index].Start(hemisphere);
+        slot_in_use[hemisphere] = 1;
+        apply_value(hemisphere, available_applets[index].id);
+        OC::DEBUG::ISR_trace_applet_ids[hemisphere] = available_applets[index].id;
+    }
+
+    // Called from loop() with the ISR held off (see LoadPendingPreset() and OnApplySysEx()). The
+    // preset's data goes straight to the new applets, without their snapshots being restored first.
+    void LoadPreset(const HemispherePreset &p) {
+        for (int h = 0; h < 2; h++)
+        {
+            StartApplet(h, p.applet[h]);
+            available_applets[p.applet[h]].OnDataReceive(h, p.data[h]);
+        }
+        select_mode = -1;
+        help_hemisphere = -1;
+    }
+
+    // The selected CV input picks a preset every 0.5V from 0V, with some hysteresis. Only a change
+    // of preset recalls it, so the applets can be edited while the CV is steady.
+    void SelectPresetByCV() {
+        ADC_CHANNEL channel = (ADC_CHANNEL)(values_[HEMISPHERE_PRESET_CV] - 1);
+        int cv = OC::ADC::raw_pitch_value(channel);
+        int centre = cv_preset * HEMISPHERE_PRESET_CV_STEP + HEMISPHERE_PRESET_CV_STEP / 2;
+        if (cv_preset < 0 || abs(cv - centre) > HEMISPHERE_PRESET_CV_STEP / 2 + HEMISPHERE_CHANGE_THRESHOLD) {
+            int preset = constrain(cv / HEMISPHERE_PRESET_CV_STEP, 0, HEMISPHERE_PRESETS - 1);
+            if (preset != cv_preset) {
+                cv_preset = preset;
+                if (presets[preset].applet[0] > -1) pending_preset = preset;
+            }
+        }
+    }
+
+    void DrawPresets() {
+        graphics.setPrintPos(1, 2);
+        graphics.print("Presets");
+        graphics.setPrintPos(86, 2);
+        if (values_[HEMISPHERE_PRESET_CV]) graphics.printf("CV %d", values_[HEMISPHERE_PRESET_CV]);
+        else graphics.print("CV off");
+        graphics.drawLine(0, 10, 127, 10);
+        graphics.drawLine(0, 12, 127, 12);
+
+        int first = constrain(preset_cursor - HEMISPHERE_PRESET_LINES / 2, 0, HEMISPHERE_PRESETS - HEMISPHERE_PRESET_LINES);
+        for (int line = 0; line < HEMISPHERE_PRESET_LINES; line++)
+        {
+            int preset = first + line;
+            int y = 15 + line * 10;
+            graphics.setPrintPos(1, y);
+            graphics.print(preset + 1);
+            const HemispherePreset &p = presets[preset];
+            if (p.applet[0] > -1) {
+                graphics.setPrintPos(10, y);
+                graphics.printf("%.9s", available_applets[p.applet[0]].name);
+                graphics.setPrintPos(70, y);
+                graphics.printf("%.9s", available_applets[p.applet[1]].name);
+            } else {
+                graphics.setPrintPos(10, y);
+                graphics.print("--");
+            }
+            if (preset == preset_cursor) graphics.invertRect(0, y - 1, 128, 9);
+        }
+    }
+
     int get_applet_index_by_id(int id) {
-        int index = 0;
+        int index = find_applet_index(id);
+        return index < 0 ? 0 : index;
+    }
+
+    int find_applet_index(int id) {
+        int index = -1;
         for (int i = 0; i < HEMISPHERE_AVAILABLE_APPLETS; i++)
         {
             if (available_applets[i].id == id) index = i;
@@ -310,23 +601,65 @@ private:
         return index;
     }
 
+    // Bus sources, four bits for each of the hemispheres' two channels: the clock source, then the CV
+    // source (see HemisphereBus)
+    uint16_t BusRoutes() {
+        uint16_t routes = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            int h = i / 2;
+            int ch = i % 2;
+            routes |= HemisphereApplet::bus.clock_source[h][ch] << (i * 4);
+            routes |= HemisphereApplet::bus.cv_source[h][ch] << (i * 4 + 2);
+        }
+        return routes;
+    }
+
+    void SetBusRoutes(uint16_t routes) {
+        for (int i = 0; i < 4; i++)
+        {
+            int h = i / 2;
+            int ch = i % 2;
+            HemisphereApplet::bus.clock_source[h][ch] = constrain((routes >> (i * 4)) & 0x03, 0, 2);
+            HemisphereApplet::bus.cv_source[h][ch] = constrain((routes >> (i * 4 + 2)) & 0x03, 0, 2);
+        }
+    }
+
+    bool BusFed(int h) {
+        const HemisphereBus &bus = HemisphereApplet::bus;
+        return bus.clock_source[h][0] || bus.clock_source[h][1] || bus.cv_source[h][0] || bus.cv_source[h][1];
+    }
+
+    // A bus clock is a rising edge of the source output since the input was last latched
+    void LatchBusClocks(int h) {
+        HemisphereBus &bus = HemisphereApplet::bus;
+        for (int ch = 0; ch < 2; ch++)
+        {
+            int source = bus.clock_source[h][ch];
+            if (source) {
+                uint16_t edges = bus.edges[1 - h][source - 1];
+                bus.clocked[h][ch] = edges != bus.edges_seen[h][ch];
+                bus.edges_seen[h][ch] = edges;
+            } else bus.clocked[h][ch] = 0;
+        }
+    }
+
     int get_next_applet_index(int index, int dir) {
         index += dir;
         if (index >= HEMISPHERE_AVAILABLE_APPLETS) index = 0;
         if (index < 0) index = HEMISPHERE_AVAILABLE_APPLETS - 1;
-
-        // If an applet uses MIDI In, it can only be selected in one
-        // hemisphere, and is designated by bit 7 set in its id.
-        if (available_applets[index].id & 0x80) {
-            if (midi_in_hemisphere == (1 - select_mode)) {
-                return get_next_applet_index(index, dir);
-            }
-        }
-
         return index;
     }
 };
 
+#define HEMISPHERE_PRESET_SETTINGS \
+    {0, 0, 255, "Preset ID L", NULL, settings::STORAGE_TYPE_U8}, \
+    {0, 0, 255, "Preset ID R", NULL, settings::STORAGE_TYPE_U8}, \
+    {0, 0, 65535, "Preset L low", NULL, settings::STORAGE_TYPE_U16}, \
+    {0, 0, 65535, "Preset R low", NULL, settings::STORAGE_TYPE_U16}, \
+    {0, 0, 65535, "Preset L high", NULL, settings::STORAGE_TYPE_U16}, \
+    {0, 0, 65535, "Preset R high", NULL, settings::STORAGE_TYPE_U16},
+
 SETTINGS_DECLARE(HemisphereManager, HEMISPHERE_SETTING_LAST) {
     {0, 0, 255, "Applet ID L", NULL, settings::STORAGE_TYPE_U8},
     {0, 0, 255, "Applet ID R", NULL, settings::STORAGE_TYPE_U8},
@@ -335,13 +668,55 @@ SETTINGS_DECLARE(HemisphereManager, HEMISPHERE_SETTING_LAST) {
     {0, 0, 65535, "Data L high", NULL, settings::STORAGE_TYPE_U16},
     {0, 0, 65535, "Data R high", NULL, settings::STORAGE_TYPE_U16},
     {0, 0, 65535, "Clock data", NULL, settings::STORAGE_TYPE_U16},
+    {0, 0, 4, "Preset CV", NULL, settings::STORAGE_TYPE_U8},
+    {0, 0, 65535, "Bus routes", NULL, settings::STORAGE_TYPE_U16},
+    HEMISPHERE_PRESET_SETTINGS
+    HEMISPHERE_PRESET_SETTINGS
+    HEMISPHERE_PRESET_SETTINGS
+    HEMISPHERE_PRESET_SETTINGS
+    HEMISPHERE_PRESET_SETTINGS
+    HEMISPHERE_PRESET_SETTINGS
+    HEMISPHERE_PRESET_SETTINGS
+    HEMISPHERE_PRESET_SETTINGS
+    {0, 0, 65535, "Clock data high", NULL, settings::STORAGE_TYPE_U16},
 };
 
 HemisphereManager manager;
 
-void ReceiveManagerSysEx() {
-    manager.OnReceiveSysEx();
+#ifdef HEMISPHERE_PROFILING
+////////////////////////////////////////////////////////////////////////////////
+//// Debug page (see OC_debug.cpp)
+////////////////////////////////////////////////////////////////////////////////
+
+void HEMISPHERE_debug() {
+    for (int h = 0; h < 2; h++)
+    {
+        int index = manager.applet_index(h);
+        const debug::HistogramCycles &controller = manager.profiler.stats(h, index, HemisphereProfiler::CONTROLLER);
+        const debug::HistogramCycles &view = manager.profiler.stats(h, index, HemisphereProfiler::VIEW);
+
+        graphics.setPrintPos(2, 12 + h * 20);
+        graphics.printf("%c%3d C%3u/%3u/%3u", h ? 'R' : 'L', manager.applet_id(index),
+                        debug::cycles_to_us(controller.min_value()),
+                        debug::cycles_to_us(controller.value()),
+                        debug::cycles_to_us(controller.max_value()));
+        graphics.setPrintPos(2, 22 + h * 20);
+        graphics.printf("     V%3u/%3u/%3u",
+                        debug::cycles_to_us(view.min_value()),
+                        debug::cycles_to_us(view.value()),
+                        debug::cycles_to_us(view.max_value()));
+        OC::DEBUG::DrawHistogram(2 + h * 64, 53, 10, controller);
+    }
+}
+
+void HEMISPHERE_debug_reset() {
+    manager.profiler.Reset();
+}
+
+void HEMISPHERE_debug_dump() {
+    manager.profiler.OnSendSysEx();
 }
+#endif // HEMISPHERE_PROFILING
 
 ////////////////////////////////////////////////////////////////////////////////
 //// O_C App Functions
@@ -367,6 +742,14 @@ size_t HEMISPHERE_restore(const void *storage) {
     return s;
 }
 
+// Versions before the preset bank stored only the applets and clock, which are still the first
+// settings, stored the same way. The rest keep their defaults.
+size_t HEMISPHERE_migrate(const void *storage, size_t length) {
+    size_t s = manager.Restore(storage, length);
+    manager.Resume();
+    return s;
+}
+
 void FASTRUN HEMISPHERE_isr() {
     manager.ExecuteControllers();
 }
@@ -377,7 +760,10 @@ void HEMISPHERE_handleAppEvent(OC::AppEvent event) {
     }
 }
 
-void HEMISPHERE_loop() {} // Essentially deprecated in favor of ISR
+void HEMISPHERE_loop() {
+    manager.LoadPendingPreset();
+    manager.ProcessSysEx();
+}
 
 void HEMISPHERE_menu() {
     manager.DrawViews();
@@ -386,6 +772,8 @@ void HEMISPHERE_menu() {
 void HEMISPHERE_screensaver() {} // Deprecated in favor of screen blanking
 
 void HEMISPHERE_handleButtonEvent(const UI::Event &event) {
+    if (manager.HandlePresetCombo(event)) return;
+
     if (event.type == UI::EVENT_BUTTON_PRESS) {
         if (event.control == OC::CONTROL_BUTTON_UP || event.control == OC::CONTROL_BUTTON_DOWN) {
             int hemisphere = (event.control == OC::CONTROL_BUTTON_UP) ? LEFT_HEMISPHERE : RIGHT_HEMISPHERE;
@@ -323,15 +323,19 @@ public:
         SendSysEx(packed, 'M');
     }
 
-    void OnReceiveSysEx() {
+    bool OnReceiveSysEx() {
+        setup_received = ExtractSysExData(received_data, 'M');
+        return true; // Logged either way
+    }
+
+    void OnApplySysEx() {
         // Since only one Setup is coming, use the currently-selected setup to determine
         // where to stash it.
-        uint8_t V[MIDI_PARAMETER_COUNT];
-        if (ExtractSysExData(V, 'M')) {
+        if (setup_received) {
             uint8_t offset = MIDI_PARAMETER_COUNT * get_setup_number();
             for (int i = 0; i < MIDI_PARAMETER_COUNT; i++)
             {
-                int p = (int)V[i];
+                int p = (int)received_data[i];
                 if (i > 15 && i < 24) p -= 24; // Restore the sign removed in OnSendSysEx()
                 apply_value(i + offset, p);
             }
@@ -382,6 +386,9 @@ public:
    }
 
 private:
+    uint8_t received_data[MIDI_PARAMETER_COUNT]; // Unpacked by OnReceiveSysEx(), for OnApplySysEx()
+    bool setup_received; // The SysEx was a Setup, rather than for another app
+
     // Housekeeping
     int screen; // 0=Assign 2=Channel 3=Transpose
     bool display; // 0=Setup Edit 1=Log
@@ -629,14 +636,15 @@ private:
     }
 
     void midi_in() {
-        if (usbMIDI.read()) {
-            int message = usbMIDI.getType();
-            int channel = usbMIDI.getChannel();
-            int data1 = usbMIDI.getData1();
-            int data2 = usbMIDI.getData2();
+        OC::MidiEvent event;
+        while (midi_events.Read(event)) {
+            int message = event.type;
+            int channel = event.channel;
+            int data1 = event.data1;
+            int data2 = event.data2;
 
             // Handle system exclusive dump for Setup data
-            if (message == MIDI_MSG_SYSEX) OnReceiveSysEx();
+            if (message == MIDI_MSG_SYSEX && event.tick == OC::CORE::ticks) QueueSysEx();
 
             // Listen for incoming clock
             if (message == MIDI_MSG_REALTIME && data1 == 0) {
@@ -869,7 +877,9 @@ void MIDI_handleAppEvent(OC::AppEvent event) {
     }
 }
 
-void MIDI_loop() {}
+void MIDI_loop() {
+    captain_midi_instance.ProcessSysEx();
+}
 
 void MIDI_menu() {
     captain_midi_instance.BaseView();
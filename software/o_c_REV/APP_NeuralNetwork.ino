@@ -106,42 +106,43 @@ public:
         SendSysEx(packed, 'N');
     }
 
-    void OnReceiveSysEx() {
-        // Since only one Setup is coming, use the currently-selected setup to determine
-        // where to stash it.
-        byte V[39];
-        if (ExtractSysExData(V, 'N')) {
-            int ix = 0;
-            byte b = 0;
+    bool OnReceiveSysEx() {
+        return ExtractSysExData(received_data, 'N');
+    }
 
-            // Decode neurons
-            for (byte n = 0; n < 6; n++)
-            {
-                byte ni = (setup * 6) + n;
-                b = V[ix++]; // Type and source 1
-                neuron[ni].type = (b >> 4) & 0x0f;
-                neuron[ni].source1 = b & 0x0f;
-                b = V[ix++]; // Source 2 and source 3
-                neuron[ni].source2 = (b >> 4) & 0x0f;
-                neuron[ni].source3 = b & 0x0f;
-                neuron[ni].weight1 = static_cast<int>(V[ix++] - 128);
-                neuron[ni].weight2 = static_cast<int>(V[ix++] - 128);
-                neuron[ni].weight3 = static_cast<int>(V[ix++] - 128);
-                neuron[ni].threshold = static_cast<int>(V[ix++] - 128);
-                neuron[ni].state = 0;
-                neuron[ni].source_state = 0;
-            }
+    // Since only one Setup is coming, use the currently-selected setup to determine
+    // where to stash it.
+    void OnApplySysEx() {
+        const byte *V = received_data;
+        int ix = 0;
+        byte b = 0;
 
-            // Decode output assignments
-            byte o = (setup * 4);
-            b = V[ix++]; // Output 1 and 2
-            output_neuron[o] = (b >> 4) & 0x0f;
-            output_neuron[o + 1] = b & 0x0f;
-            b = V[ix++]; // Output 3 and 4
-            output_neuron[o + 2] = (b >> 4) & 0x0f;
-            output_neuron[o + 3] = b & 0x0f;
+        // Decode neurons
+        for (byte n = 0; n < 6; n++)
+        {
+            byte ni = (setup * 6) + n;
+            b = V[ix++]; // Type and source 1
+            neuron[ni].type = (b >> 4) & 0x0f;
+            neuron[ni].source1 = b & 0x0f;
+            b = V[ix++]; // Source 2 and source 3
+            neuron[ni].source2 = (b >> 4) & 0x0f;
+            neuron[ni].source3 = b & 0x0f;
+            neuron[ni].weight1 = static_cast<int>(V[ix++] - 128);
+            neuron[ni].weight2 = static_cast<int>(V[ix++] - 128);
+            neuron[ni].weight3 = static_cast<int>(V[ix++] - 128);
+            neuron[ni].threshold = static_cast<int>(V[ix++] - 128);
+            neuron[ni].state = 0;
+            neuron[ni].source_state = 0;
         }
 
+        // Decode output assignments
+        byte o = (setup * 4);
+        b = V[ix++]; // Output 1 and 2
+        output_neuron[o] = (b >> 4) & 0x0f;
+        output_neuron[o + 1] = b & 0x0f;
+        b = V[ix++]; // Output 3 and 4
+        output_neuron[o + 2] = (b >> 4) & 0x0f;
+        output_neuron[o + 3] = b & 0x0f;
     }
 
     /* Perform a copy or sysex dump */
@@ -226,6 +227,8 @@ public:
     }
 
 private:
+    byte received_data[39]; // Unpacked by OnReceiveSysEx(), for OnApplySysEx()
+
     // Screen and edit states
     byte cursor = 0; // Cursor on the neuron select screen
     int selected = 0; // 0-5, which neuron is currently selected
@@ -614,7 +617,9 @@ void NeuralNetwork_handleAppEvent(OC::AppEvent event) {
     }
 }
 
-void NeuralNetwork_loop() {} // Deprecated
+void NeuralNetwork_loop() {
+    NeuralNetwork_instance.ProcessSysEx();
+}
 
 void NeuralNetwork_menu() {
     NeuralNetwork_instance.BaseView();
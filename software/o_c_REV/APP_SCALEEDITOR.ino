@@ -90,7 +90,7 @@ public:
     }
 
     /* Send SysEx on app suspend and when the left encoder is pressed */
-    void OnReceiveSysEx() {
+    bool OnReceiveSysEx() {
         uint8_t V[35];
         if (ExtractSysExData(V, 'E')) {
             int ix = 0;
@@ -98,27 +98,33 @@ public:
             // Decode span
             uint8_t low = V[ix++];
             uint8_t high = V[ix++];
-            OC::user_scales[current_scale].span = (int16_t)(high << 8) | low;
+            received_scale.span = (int16_t)(high << 8) | low;
 
             // Decode length
             uint8_t num_notes = V[ix++];
-            OC::user_scales[current_scale].num_notes = constrain(num_notes, 4, 16);
+            received_scale.num_notes = constrain(num_notes, 4, 16);
 
             // Decode values
             for (int i = 0; i < 16; i++)
             {
                 uint8_t low = V[ix++];
                 uint8_t high = V[ix++];
-                OC::user_scales[current_scale].notes[i] = (uint16_t)(high << 8) | low;
+                received_scale.notes[i] = (uint16_t)(high << 8) | low;
             }
-
-            // Reset
-            current_note = 0;
-            undo_value = OC::user_scales[current_scale].notes[current_note];
-            // Configure and force requantize for real-time monitoring purposes
-            quantizer.Configure(OC::Scales::GetScale(current_scale), 0xffff);
-            QuantizeCurrent();
+            return true;
         }
+        return false;
+    }
+
+    void OnApplySysEx() {
+        OC::user_scales[current_scale] = received_scale;
+
+        // Reset
+        current_note = 0;
+        undo_value = OC::user_scales[current_scale].notes[current_note];
+        // Configure and force requantize for real-time monitoring purposes
+        quantizer.Configure(OC::Scales::GetScale(current_scale), 0xffff);
+        QuantizeCurrent();
     }
 
     /////////////////////////////////////////////////////////////////
@@ -175,6 +181,7 @@ private:
     int octave;
     SegmentDisplay segment;
     SegmentDisplay tinynumbers;
+    OC::Scale received_scale; // From OnReceiveSysEx(), for OnApplySysEx()
 
     void DrawInterface() {
         // The interface is a spreadsheet-like 4x4 grid, with each
@@ -363,7 +370,9 @@ void SCALEEDITOR_handleAppEvent(OC::AppEvent event) {
     }
 }
 
-void SCALEEDITOR_loop() {}
+void SCALEEDITOR_loop() {
+    scale_editor_instance.ProcessSysEx();
+}
 
 void SCALEEDITOR_menu() {
     scale_editor_instance.BaseView();
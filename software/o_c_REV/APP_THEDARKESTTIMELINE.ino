@@ -51,6 +51,7 @@ class TheDarkestTimeline : public HSApplication, public SystemExclusiveHandler,
 public:
 	void Start() {
         quantizer.Init();
+        quantizer.EnableTable(quantizer_table);
         quantizer.Configure(OC::Scales::GetScale(5), 0xffff);
         Resume();
 	}
@@ -72,14 +73,15 @@ public:
         bool note_on = 0;
         uint8_t in_note_number = 0;
         uint8_t in_velocity = 0;
-        if (usbMIDI.read()) {
-            int message = usbMIDI.getType();
-            int channel = usbMIDI.getChannel();
-            int data1 = usbMIDI.getData1();
-            int data2 = usbMIDI.getData2();
+        OC::MidiEvent event;
+        while (midi_events.Read(event)) {
+            int message = event.type;
+            int channel = event.channel;
+            int data1 = event.data1;
+            int data2 = event.data2;
 
             // Handle system exclusive dump for Setup data
-            if (message == MIDI_MSG_SYSEX) OnReceiveSysEx();
+            if (message == MIDI_MSG_SYSEX && event.tick == OC::CORE::ticks) QueueSysEx();
 
             if (message == MIDI_MSG_NOTE_ON && channel == midi_channel_in()) {
                 note_on = 1;
@@ -173,7 +175,7 @@ public:
                 clocked = 0; // Reset the clock
 
                 // Calculate normal probability for Output 3
-                int prob = random(0, HSAPPLICATION_5V);
+                int prob = Random(0, HSAPPLICATION_5V);
                 if (prob < cv || Gate(3)) { // Gate at digital 4 makes all probabilities certainties
                     ClockOut(2, gate_ticks);
 
@@ -190,7 +192,7 @@ public:
                 }
 
                 // Calculate complementary probability for Output 4
-                prob = random(0, HSAPPLICATION_5V);
+                prob = Random(0, HSAPPLICATION_5V);
                 if (prob < (HSAPPLICATION_5V - cv) || Gate(3)) {
                     ClockOut(3, gate_ticks);
 
@@ -266,29 +268,31 @@ public:
         SendSysEx(packed, 'D');
     }
 
-    void OnReceiveSysEx() {
-        uint8_t V[35];
-        if (ExtractSysExData(V, 'D')) {
-            int ix = 0;
-            int page = V[ix++];
-            if (page < 4) {
-                // CV data pages 0-3
-                values_[DT_LENGTH] = V[ix++]; // V1.3 legacy support
-                values_[DT_INDEX] = V[ix++];
-                for (int b = 0; b < 16; b++)
-                {
-                    uint8_t low = V[ix++];
-                    uint8_t high = V[ix++];
-                    uint16_t cv = (uint16_t)(high << 8) | low;
-                    OC::user_patterns[page].notes[b] = constrain(cv, 0, HSAPPLICATION_5V);
-                }
-            } else if (page == 4) {
-                // Metadata page 4
-                values_[DT_LENGTH] = V[ix++];
-                values_[DT_INDEX] = V[ix++];
-                values_[DT_SCALE] = V[ix++];
-                values_[DT_ROOT] = V[ix++];
+    bool OnReceiveSysEx() {
+        return ExtractSysExData(received_data, 'D');
+    }
+
+    void OnApplySysEx() {
+        const uint8_t *V = received_data;
+        int ix = 0;
+        int page = V[ix++];
+        if (page < 4) {
+            // CV data pages 0-3
+            values_[DT_LENGTH] = V[ix++]; // V1.3 legacy support
+            values_[DT_INDEX] = V[ix++];
+            for (int b = 0; b < 16; b++)
+            {
+                uint8_t low = V[ix++];
+                uint8_t high = V[ix++];
+                uint16_t cv = (uint16_t)(high << 8) | low;
+                OC::user_patterns[page].notes[b] = constrain(cv, 0, HSAPPLICATION_5V);
             }
+        } else if (page == 4) {
+            // Metadata page 4
+            values_[DT_LENGTH] = V[ix++];
+            values_[DT_INDEX] = V[ix++];
+            values_[DT_SCALE] = V[ix++];
+            values_[DT_ROOT] = V[ix++];
         }
     }
 
@@ -317,7 +321,7 @@ public:
         {
             for (uint8_t s = 0; s < 32; s++)
             {
-                write_data_at(s, tl, random(0, HSAPPLICATION_5V));
+                write_data_at(s, tl, Random(0, HSAPPLICATION_5V));
             }
         }
     }
@@ -364,11 +368,14 @@ public:
     }
 
 private:
+    uint8_t received_data[35]; // Unpacked by OnReceiveSysEx(), for OnApplySysEx()
+
     // Internal States
     int8_t cursor; // The play/record point within the sequence
     bool record[2]; // 0 = CV Timeline, 1 = Proability Timeline
     bool index_edit_enabled; // The index is being edited via the panel
     braids::Quantizer quantizer;
+    braids::QuantizerTable quantizer_table;
     uint8_t setup_screen; // Setup screen state
     int setup_screen_timeout_countdown;
     bool clocked; // Sequencer has been clocked, and a probability trigger needs to be determined
@@ -554,7 +561,9 @@ void TheDarkestTimeline_handleAppEvent(OC::AppEvent event) {
     }
 }
 
-void TheDarkestTimeline_loop() {} // Deprecated
+void TheDarkestTimeline_loop() {
+    TheDarkestTimeline_instance.ProcessSysEx();
+}
 
 void TheDarkestTimeline_menu() {
     TheDarkestTimeline_instance.BaseView();
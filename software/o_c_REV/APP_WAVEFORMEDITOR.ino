@@ -114,21 +114,23 @@ public:
         }
     }
 
-    void OnReceiveSysEx() {
-        uint8_t V[35];
-        if (ExtractSysExData(V, 'W')) {
-            int ix = 0;
-            byte gr = V[ix++];
-            for (byte s = 0; s < 16; s++)
-            {
-                byte seg_ix = (gr * 4) + s;
-                HS::user_waveforms[seg_ix].level = V[ix++];
-                HS::user_waveforms[seg_ix].time = V[ix++];
-            }
+    bool OnReceiveSysEx() {
+        return ExtractSysExData(received_data, 'W');
+    }
 
-            waveform_number = 0;
-            Resume();
+    void OnApplySysEx() {
+        const uint8_t *V = received_data;
+        int ix = 0;
+        byte gr = V[ix++];
+        for (byte s = 0; s < 16; s++)
+        {
+            byte seg_ix = (gr * 4) + s;
+            HS::user_waveforms[seg_ix].level = V[ix++];
+            HS::user_waveforms[seg_ix].time = V[ix++];
         }
+
+        waveform_number = 0;
+        Resume();
     }
 
     /////////////////////////////////////////////////////////////////
@@ -214,6 +216,7 @@ private:
     byte segment_number = 0;
     byte waveform_count;
     byte segments_remaining;
+    uint8_t received_data[35]; // Unpacked by OnReceiveSysEx(), for OnApplySysEx()
 
     bool add_delete_confirm = 0; // 1=Show add/delete confirmation screen
     bool add_waveform = 1; // 1=Add waveform, 0=Delete waveform
@@ -388,7 +391,9 @@ void WaveformEditor_handleAppEvent(OC::AppEvent event) {
     }
 }
 
-void WaveformEditor_loop() {} // Deprecated
+void WaveformEditor_loop() {
+    WaveformEditor_instance.ProcessSysEx();
+}
 
 void WaveformEditor_menu() {
     WaveformEditor_instance.BaseView();
@@ -175,10 +175,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ADEG ADEG_instance[2];
+AppletSlot<ADEG> ADEG_instance;
 
-void ADEG_Start(bool hemisphere) {ADEG_instance[hemisphere].BaseStart(hemisphere);}
-void ADEG_Controller(bool hemisphere, bool forwarding) {ADEG_instance[hemisphere].BaseController(forwarding);}
+void ADEG_Start(bool hemisphere) {ADEG_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void ADEG_Controller(bool hemisphere, bool forwarding) {ADEG_instance.Controller(hemisphere, forwarding);}
 void ADEG_View(bool hemisphere) {ADEG_instance[hemisphere].BaseView();}
 void ADEG_OnButtonPress(bool hemisphere) {ADEG_instance[hemisphere].OnButtonPress();}
 void ADEG_OnEncoderMove(bool hemisphere, int direction) {ADEG_instance[hemisphere].OnEncoderMove(direction);}
@@ -270,14 +270,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ADSREG ADSREG_instance[2];
+AppletSlot<ADSREG> ADSREG_instance;
 
 void ADSREG_Start(bool hemisphere) {
-    ADSREG_instance[hemisphere].BaseStart(hemisphere);
+    ADSREG_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void ADSREG_Controller(bool hemisphere, bool forwarding) {
-    ADSREG_instance[hemisphere].BaseController(forwarding);
+    ADSREG_instance.Controller(hemisphere, forwarding);
 }
 
 void ADSREG_View(bool hemisphere) {
@@ -147,10 +147,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ASR ASR_instance[2];
+AppletSlot<ASR> ASR_instance;
 
-void ASR_Start(bool hemisphere) {ASR_instance[hemisphere].BaseStart(hemisphere);}
-void ASR_Controller(bool hemisphere, bool forwarding) {ASR_instance[hemisphere].BaseController(forwarding);}
+void ASR_Start(bool hemisphere) {ASR_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void ASR_Controller(bool hemisphere, bool forwarding) {ASR_instance.Controller(hemisphere, forwarding);}
 void ASR_View(bool hemisphere) {ASR_instance[hemisphere].BaseView();}
 void ASR_OnButtonPress(bool hemisphere) {ASR_instance[hemisphere].OnButtonPress();}
 void ASR_OnEncoderMove(bool hemisphere, int direction) {ASR_instance[hemisphere].OnEncoderMove(direction);}
@@ -44,8 +44,7 @@ public:
             pattern[ch] = EuclideanPattern(length[ch] - 1, beats[ch], 0);;
         }
         step = 0;
-        SetDisplayPositions(0, 24);
-        SetDisplayPositions(1, 16);
+        stale_positions = 0x03;
         last_clock = OC::CORE::ticks;
     }
 
@@ -74,6 +73,13 @@ public:
     }
 
     void View() {
+        ForEachChannel(ch)
+        {
+            if (stale_positions & (0x01 << ch)) {
+                stale_positions &= ~(0x01 << ch);
+                SetDisplayPositions(ch, 24 - (8 * ch));
+            }
+        }
         gfxHeader(applet_name());
         DrawSteps();
         if (display_timeout > 0) DrawEditor();
@@ -92,7 +98,7 @@ public:
         if (f == 0) {
             length[ch] = constrain(length[ch] + direction, 3, 32);
             if (beats[ch] > length[ch]) beats[ch] = length[ch];
-            SetDisplayPositions(ch, 24 - (8 * ch));
+            stale_positions |= 0x01 << ch;
         }
         if (f == 1) {
             beats[ch] = constrain(beats[ch] + direction, 1, length[ch]);
@@ -113,8 +119,7 @@ public:
         beats[0] = Unpack(data, PackLocation {4,4}) + 1;
         length[1] = Unpack(data, PackLocation {8,4}) + 1;
         beats[1] = Unpack(data, PackLocation {12,4}) + 1;
-        SetDisplayPositions(0, 24);
-        SetDisplayPositions(1, 16);
+        stale_positions = 0x03;
     }
 
 protected:
@@ -134,6 +139,7 @@ private:
     uint32_t pattern[2];
     int last_clock;
     uint32_t display_timeout;
+    uint8_t stale_positions; // Channels whose disp_coord View() must recompute
     
     // Settings
     int length[2];
@@ -252,14 +258,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-AnnularFusion AnnularFusion_instance[2];
+AppletSlot<AnnularFusion> AnnularFusion_instance;
 
 void AnnularFusion_Start(bool hemisphere) {
-    AnnularFusion_instance[hemisphere].BaseStart(hemisphere);
+    AnnularFusion_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void AnnularFusion_Controller(bool hemisphere, bool forwarding) {
-    AnnularFusion_instance[hemisphere].BaseController(forwarding);
+    AnnularFusion_instance.Controller(hemisphere, forwarding);
 }
 
 void AnnularFusion_View(bool hemisphere) {
@@ -121,10 +121,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-AttenuateOffset AttenuateOffset_instance[2];
+AppletSlot<AttenuateOffset> AttenuateOffset_instance;
 
-void AttenuateOffset_Start(bool hemisphere) {AttenuateOffset_instance[hemisphere].BaseStart(hemisphere);}
-void AttenuateOffset_Controller(bool hemisphere, bool forwarding) {AttenuateOffset_instance[hemisphere].BaseController(forwarding);}
+void AttenuateOffset_Start(bool hemisphere) {AttenuateOffset_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void AttenuateOffset_Controller(bool hemisphere, bool forwarding) {AttenuateOffset_instance.Controller(hemisphere, forwarding);}
 void AttenuateOffset_View(bool hemisphere) {AttenuateOffset_instance[hemisphere].BaseView();}
 void AttenuateOffset_OnButtonPress(bool hemisphere) {AttenuateOffset_instance[hemisphere].OnButtonPress();}
 void AttenuateOffset_OnEncoderMove(bool hemisphere, int direction) {AttenuateOffset_instance[hemisphere].OnEncoderMove(direction);}
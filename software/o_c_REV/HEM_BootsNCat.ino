@@ -22,6 +22,7 @@
 #include "vector_osc/WaveformManager.h"
 
 #define BNC_MAX_PARAM 63
+#define BNC_NOISE_BLOCK 8
 
 class BootsNCat : public HemisphereApplet {
 public:
@@ -36,6 +37,7 @@ public:
         tone[1] = 55; // Snare low limit
         decay[1] = 16; // Snare decay
         noise_tone_countdown = 1;
+        noise_index = 0;
         blend = 0;
 
         bass = WaveformManager::VectorOscillatorFromWaveform(HS::Triangle);
@@ -74,7 +76,10 @@ public:
 
         // Calculate snare drum signal
         if (--noise_tone_countdown == 0) {
-            noise = random(0, (12 << 7) * 6) - ((12 << 7) * 3);
+            if ((noise_index & (BNC_NOISE_BLOCK - 1)) == 0) {
+                RandomGenerator().Fill(noise_block, BNC_NOISE_BLOCK, -(12 << 7) * 3, (12 << 7) * 3);
+            }
+            noise = noise_block[noise_index++ & (BNC_NOISE_BLOCK - 1)];
             noise_tone_countdown = BNC_MAX_PARAM - tone[1] + 1;
         }
 
@@ -158,6 +163,8 @@ private:
     VectorOscillator eg[2];
     int noise_tone_countdown = 0;
     uint32_t noise;
+    int16_t noise_block[BNC_NOISE_BLOCK]; // Noise samples are generated a block at a time
+    uint8_t noise_index;
     int levels[2]; // For display
     
     // Settings
@@ -211,10 +218,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-BootsNCat BootsNCat_instance[2];
+AppletSlot<BootsNCat> BootsNCat_instance;
 
-void BootsNCat_Start(bool hemisphere) {BootsNCat_instance[hemisphere].BaseStart(hemisphere);}
-void BootsNCat_Controller(bool hemisphere, bool forwarding) {BootsNCat_instance[hemisphere].BaseController(forwarding);}
+void BootsNCat_Start(bool hemisphere) {BootsNCat_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void BootsNCat_Controller(bool hemisphere, bool forwarding) {BootsNCat_instance.Controller(hemisphere, forwarding);}
 void BootsNCat_View(bool hemisphere) {BootsNCat_instance[hemisphere].BaseView();}
 void BootsNCat_OnButtonPress(bool hemisphere) {BootsNCat_instance[hemisphere].OnButtonPress();}
 void BootsNCat_OnEncoderMove(bool hemisphere, int direction) {BootsNCat_instance[hemisphere].OnEncoderMove(direction);}
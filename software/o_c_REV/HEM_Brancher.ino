@@ -35,7 +35,7 @@ public:
 
         if (Clock(0)) {
             int prob = p + Proportion(DetentedIn(0), HEMISPHERE_MAX_CV, 100);
-            choice = (random(1, 100) <= prob) ? 0 : 1;
+            choice = (Random(1, 100) <= prob) ? 0 : 1;
 
             // If Master Clock Forwarding is enabled, respond to this clock by
             // sending a clock
@@ -105,14 +105,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Brancher Brancher_instance[2];
+AppletSlot<Brancher> Brancher_instance;
 
 void Brancher_Start(bool hemisphere) {
-    Brancher_instance[hemisphere].BaseStart(hemisphere);
+    Brancher_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Brancher_Controller(bool hemisphere, bool forwarding) {
-	Brancher_instance[hemisphere].BaseController(forwarding);
+	Brancher_instance.Controller(hemisphere, forwarding);
 }
 
 void Brancher_View(bool hemisphere) {
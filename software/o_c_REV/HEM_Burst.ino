@@ -53,11 +53,9 @@ public:
         if (Clock(0)) {
             if (clocked) {
                 // Get a tempo, if this is the second tick or later since the last clock
-                spacing = (ticks_since_clock / number) / 17;
-                ticks_since_clock = 0;
+                spacing = (ClockCycleCycles(0) / OC::DigitalInputs::kCyclesPerTick / number) / 17;
             } else clocked = 1;
         }
-        ticks_since_clock++;
 
         // Get spacing with clock division or multiplication calculated
         int effective_spacing = get_effective_spacing();
@@ -148,7 +146,6 @@ private:
     int bursts_to_go; // Counts down to end of burst set
     bool clocked; // When a clock signal is received at Digital 1, clocked is activated, and the
                   // spacing of a new burst is number/clock length.
-    int ticks_since_clock; // When clocked, this is the time since the last clock.
     int last_number_cv_tick; // The last time the number was changed via CV. This is used to
                              // decide whether the ADC delay should be used when clocks come in.
 
@@ -205,14 +202,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Burst Burst_instance[2];
+AppletSlot<Burst> Burst_instance;
 
 void Burst_Start(bool hemisphere) {
-    Burst_instance[hemisphere].BaseStart(hemisphere);
+    Burst_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Burst_Controller(bool hemisphere, bool forwarding) {
-    Burst_instance[hemisphere].BaseController(forwarding);
+    Burst_instance.Controller(hemisphere, forwarding);
 }
 
 void Burst_View(bool hemisphere) {
@@ -110,10 +110,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Button Button_instance[2];
+AppletSlot<Button> Button_instance;
 
-void Button_Start(bool hemisphere) {Button_instance[hemisphere].BaseStart(hemisphere);}
-void Button_Controller(bool hemisphere, bool forwarding) {Button_instance[hemisphere].BaseController(forwarding);}
+void Button_Start(bool hemisphere) {Button_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void Button_Controller(bool hemisphere, bool forwarding) {Button_instance.Controller(hemisphere, forwarding);}
 void Button_View(bool hemisphere) {Button_instance[hemisphere].BaseView();}
 void Button_OnButtonPress(bool hemisphere) {Button_instance[hemisphere].OnButtonPress();}
 void Button_OnEncoderMove(bool hemisphere, int direction) {Button_instance[hemisphere].OnEncoderMove(direction);}
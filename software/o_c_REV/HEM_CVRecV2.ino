@@ -200,10 +200,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-CVRecV2 CVRecV2_instance[2];
+AppletSlot<CVRecV2> CVRecV2_instance;
 
-void CVRecV2_Start(bool hemisphere) {CVRecV2_instance[hemisphere].BaseStart(hemisphere);}
-void CVRecV2_Controller(bool hemisphere, bool forwarding) {CVRecV2_instance[hemisphere].BaseController(forwarding);}
+void CVRecV2_Start(bool hemisphere) {CVRecV2_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void CVRecV2_Controller(bool hemisphere, bool forwarding) {CVRecV2_instance.Controller(hemisphere, forwarding);}
 void CVRecV2_View(bool hemisphere) {CVRecV2_instance[hemisphere].BaseView();}
 void CVRecV2_OnButtonPress(bool hemisphere) {CVRecV2_instance[hemisphere].OnButtonPress();}
 void CVRecV2_OnEncoderMove(bool hemisphere, int direction) {CVRecV2_instance[hemisphere].OnEncoderMove(direction);}
@@ -65,10 +65,10 @@ public:
                 // value with each clock pulse. Otherwise, Rand is unclocked, and outputs
                 // a random value with each tick.
                 if (Clock(ch)) {
-                    Out(ch, random(0, HEMISPHERE_MAX_CV));
+                    Out(ch, Random(0, HEMISPHERE_MAX_CV));
                     rand_clocked[ch] = 1;
                 }
-                else if (!rand_clocked[ch]) Out(ch, random(0, HEMISPHERE_MAX_CV));
+                else if (!rand_clocked[ch]) Out(ch, Random(0, HEMISPHERE_MAX_CV));
             } else if (idx < 5) {
                 int result = calc_fn[idx](In(0), In(1));
                 Out(ch, result);
@@ -143,14 +143,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Calculate Calculate_instance[2];
+AppletSlot<Calculate> Calculate_instance;
 
 void Calculate_Start(bool hemisphere) {
-    Calculate_instance[hemisphere].BaseStart(hemisphere);
+    Calculate_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Calculate_Controller(bool hemisphere, bool forwarding) {
-    Calculate_instance[hemisphere].BaseController(forwarding);
+    Calculate_instance.Controller(hemisphere, forwarding);
 }
 
 void Calculate_View(bool hemisphere) {
@@ -206,14 +206,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Carpeggio Carpeggio_instance[2];
+AppletSlot<Carpeggio> Carpeggio_instance;
 
 void Carpeggio_Start(bool hemisphere) {
-    Carpeggio_instance[hemisphere].BaseStart(hemisphere);
+    Carpeggio_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Carpeggio_Controller(bool hemisphere, bool forwarding) {
-    Carpeggio_instance[hemisphere].BaseController(forwarding);
+    Carpeggio_instance.Controller(hemisphere, forwarding);
 }
 
 void Carpeggio_View(bool hemisphere) {
@@ -39,8 +39,6 @@ public:
     }
 
     void Controller() {
-        int this_tick = OC::CORE::ticks;
-
         // Set division via CV
         ForEachChannel(ch)
         {
@@ -58,20 +56,20 @@ public:
 
         // The input was clocked; set timing info
         if (Clock(0) && !Gate(1)) {
-        		cycle_time = ClockCycleTicks(0);
+            cycle_time = ClockCycleCycles(0);
             // At the clock input, handle clock division
             ForEachChannel(ch)
             {
-                count[ch]++;
+                count[ch] += ClockEdges(0); // Triggers faster than the tick still count
                 if (div[ch] > 0) { // Positive value indicates clock division
                     if (count[ch] >= div[ch]) {
-                        count[ch] = 0; // Reset
+                        count[ch] %= div[ch]; // Reset
                         ClockOut(ch);
                     }
                 } else {
-                    // Calculate next clock for multiplication on each clock
-                    int clock_every = (cycle_time / -div[ch]);
-                    next_clock[ch] = this_tick + clock_every;
+                    // Calculate next clock for multiplication on each clock, from the
+                    // time of the clock edge rather than the tick, so it doesn't jitter
+                    next_clock[ch] = ClockCycles(0) + cycle_time / -div[ch];
                     ClockOut(ch); // Sync
                 }
             }
@@ -80,10 +78,9 @@ public:
         // Handle clock multiplication
         ForEachChannel(ch)
         {
-            if (div[ch] < 0) { // Negative value indicates clock multiplication
-                if (this_tick >= next_clock[ch]) {
-                    int clock_every = (cycle_time / -div[ch]);
-                    next_clock[ch] += clock_every;
+            if (div[ch] < 0 && cycle_time) { // Negative value indicates clock multiplication
+                if (static_cast<int32_t>(TickCycles() - next_clock[ch]) >= 0) {
+                    next_clock[ch] += cycle_time / -div[ch];
                     ClockOut(ch);
                 }
             }
@@ -132,9 +129,9 @@ protected:
 private:
     int div[2]; // Division data for outputs. Positive numbers are divisions, negative numbers are multipliers
     int count[2]; // Number of clocks since last output (for clock divide)
-    int next_clock[2]; // Tick number for the next output (for clock multiply)
+    uint32_t next_clock[2]; // Cycle count for the next output (for clock multiply)
     int cursor; // Which output is currently being edited
-    int cycle_time; // Cycle time between the last two clock inputs
+    uint32_t cycle_time; // Cycles between the last two clock inputs
 
     void DrawSelector() {
         ForEachChannel(ch)
@@ -165,14 +162,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ClockDivider ClockDivider_instance[2];
+AppletSlot<ClockDivider> ClockDivider_instance;
 
 void ClockDivider_Start(bool hemisphere) {
-    ClockDivider_instance[hemisphere].BaseStart(hemisphere);
+    ClockDivider_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void ClockDivider_Controller(bool hemisphere, bool forwarding) {
-    ClockDivider_instance[hemisphere].BaseController(forwarding);
+    ClockDivider_instance.Controller(hemisphere, forwarding);
 }
 
 void ClockDivider_View(bool hemisphere) {
@@ -36,48 +36,75 @@ public:
     }
 
     void OnButtonPress() {
-        if (++cursor > 2) cursor = 0;
+        if (++cursor > 12) cursor = 0;
     }
 
     void OnEncoderMove(int direction) {
-        if (cursor == 0) { // Source
-            if (clock_m->IsRunning() || clock_m->IsPaused()) clock_m->Stop();
+        if (cursor == 0) { // Source: forward, internal or MIDI
+            int source = clock_m->IsMidiSync() ? 2 : (clock_m->IsRunning() || clock_m->IsPaused());
+            source = (source + direction + 3) % 3;
+            clock_m->SetMidiSync(source == 2);
+            if (source == 0) clock_m->Stop();
             else {
                 clock_m->Start();
-                clock_m->Pause();
+                if (source == 1) clock_m->Pause();
             }
         }
 
         if (cursor == 1) { // Set tempo
             uint16_t bpm = clock_m->GetTempo();
             bpm += direction;
-            clock_m->SetTempoBPM(bpm);
+            clock_m->SetTempoBPM(bpm, clock_m->GetTempoHundredths());
         }
 
-        if (cursor == 2) { // Set multiplier
+        if (cursor == 2) { // Set hundredths of a BPM
+            int hundredths = clock_m->GetTempoHundredths() + direction;
+            clock_m->SetTempoBPM(clock_m->GetTempo(), constrain(hundredths, 0, 99));
+        }
+
+        if (cursor == 3) { // Set multiplier
             int8_t mult = clock_m->GetMultiply();
             mult += direction;
             clock_m->SetMultiply(mult);
         }
+
+        if (cursor == 4) { // Set swing
+            clock_m->SetSwing(clock_m->GetSwing() + direction);
+        }
+
+        if (cursor > 4) { // Bus sources: jack, or either output of the other hemisphere
+            uint8_t &source = BusSource(cursor - 5);
+            source = constrain(source + direction, 0, 2);
+        }
     }
 
+    /* The manager stores the low and high 16 bits in separate settings. The low ones are as they
+     * were before the tempo hundredths, swing and MIDI sync were added, so those are in the high
+     * setting, and default to 0 when it's missing from older settings.
+     */
     uint32_t OnDataRequest() {
         uint32_t data = 0;
         Pack(data, PackLocation { 0, 1 }, clock_m->IsRunning() || clock_m->IsPaused());
         Pack(data, PackLocation { 1, 9 }, clock_m->GetTempo());
         Pack(data, PackLocation { 10, 5 }, clock_m->GetMultiply());
+        Pack(data, PackLocation { 15, 7 }, clock_m->GetTempoHundredths());
+        Pack(data, PackLocation { 22, 5 }, clock_m->GetSwing() - CLOCK_SWING_MIN);
+        Pack(data, PackLocation { 27, 1 }, clock_m->IsMidiSync());
         return data;
     }
 
     void OnDataReceive(uint32_t data) {
+        bool midi_sync = Unpack(data, PackLocation { 27, 1 });
+        clock_m->SetMidiSync(midi_sync);
         if (Unpack(data, PackLocation { 0, 1 })) {
             clock_m->Start();
-            clock_m->Pause();
+            if (!midi_sync) clock_m->Pause();
         } else {
             clock_m->Stop();
         }
-        clock_m->SetTempoBPM(Unpack(data, PackLocation { 1, 9 }));
+        clock_m->SetTempoBPM(Unpack(data, PackLocation { 1, 9 }), Unpack(data, PackLocation { 15, 7 }));
         clock_m->SetMultiply(Unpack(data, PackLocation { 10, 5 }));
+        clock_m->SetSwing(Unpack(data, PackLocation { 22, 5 }) + CLOCK_SWING_MIN);
     }
 
 protected:
@@ -91,9 +118,16 @@ protected:
     }
 
 private:
-    int cursor; // 0=Source, 1=Tempo, 2=Multiply
+    int cursor; // 0=Source, 1=Tempo, 2=Tempo hundredths, 3=Multiply, 4=Swing, 5-8=Trig 1-4 bus source, 9-12=CV 1-4 bus source
     ClockManager *clock_m = clock_m->get();
 
+    // Bus source for Trig (0-3) or CV (4-7) inputs 1-4
+    uint8_t &BusSource(int input) {
+        int h = (input & 0x03) / 2;
+        int ch = input & 0x01;
+        return input < 4 ? bus.clock_source[h][ch] : bus.cv_source[h][ch];
+    }
+
     void DrawInterface() {
         // Header: This is sort of a faux applet, so its header
         // needs to extend across the screen
@@ -105,7 +139,10 @@ private:
         graphics.drawLine(0, 12, 127, 12);
 
         // Clock Source
-        if (clock_m->IsRunning()) {
+        if (clock_m->IsMidiSync()) {
+            gfxIcon(1, 15, clock_m->IsPaused() ? PAUSE_ICON : MIDI_ICON);
+            gfxPrint(16, 15, clock_m->IsMidiLocked() ? "MIDI lock" : "MIDI");
+        } else if (clock_m->IsRunning()) {
             gfxIcon(1, 15, PLAY_ICON);
             gfxPrint(16, 15, "Internal");
         } else if (clock_m->IsPaused()) {
@@ -120,15 +157,38 @@ private:
         gfxIcon(1, 25, NOTE4_ICON);
         gfxPrint(9, 25, "= ");
         gfxPrint(pad(100, clock_m->GetTempo()), clock_m->GetTempo());
+        gfxPrint(".");
+        if (clock_m->GetTempoHundredths() < 10) gfxPrint("0");
+        gfxPrint(clock_m->GetTempoHundredths());
         gfxPrint(" BPM");
 
-        // Multiply
+        // Multiply and swing
         gfxPrint(1, 35, "x");
         gfxPrint(clock_m->GetMultiply());
+        gfxPrint(34, 35, "Swing ");
+        gfxPrint(clock_m->GetSwing());
+        gfxPrint("%");
+
+        // Bus: each input shows the output it takes from the other hemisphere, or - for the jack
+        const char *outputs[] = {"-", "A", "B", "C", "D"};
+        gfxPrint(1, 45, "Trig");
+        gfxPrint(1, 55, "CV");
+        for (int input = 0; input < 8; input++)
+        {
+            int jack = input & 0x03;
+            int x = 34 + jack * 24;
+            int y = input < 4 ? 45 : 55;
+            int source = BusSource(input);
+            gfxPrint(x, y, jack + 1);
+            gfxPrint(outputs[source ? source + (jack < 2 ? 2 : 0) : 0]);
+            if (cursor == input + 5) gfxCursor(x + 6, y + 8, 7);
+        }
 
         if (cursor == 0) gfxCursor(16, 23, 46);
         if (cursor == 1) gfxCursor(23, 33, 18);
-        if (cursor == 2) gfxCursor(8, 43, 12);
+        if (cursor == 2) gfxCursor(45, 33, 12);
+        if (cursor == 3) gfxCursor(8, 43, 12);
+        if (cursor == 4) gfxCursor(70, 43, 12);
     }
 };
 
@@ -144,7 +204,7 @@ private:
 ClockSetup ClockSetup_instance[1];
 
 void ClockSetup_Start(bool hemisphere) {ClockSetup_instance[hemisphere].BaseStart(hemisphere);}
-void ClockSetup_Controller(bool hemisphere, bool forwarding) {ClockSetup_instance[hemisphere].BaseController(forwarding);}
+void ClockSetup_Controller(bool hemisphere, bool forwarding) {ClockSetup_instance[hemisphere].BaseController<ClockSetup>(forwarding);}
 void ClockSetup_View(bool hemisphere) {ClockSetup_instance[hemisphere].BaseView();}
 void ClockSetup_OnButtonPress(bool hemisphere) {ClockSetup_instance[hemisphere].OnButtonPress();}
 void ClockSetup_OnEncoderMove(bool hemisphere, int direction) {ClockSetup_instance[hemisphere].OnEncoderMove(direction);}
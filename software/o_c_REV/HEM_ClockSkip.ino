@@ -38,7 +38,7 @@ public:
         {
             if (Clock(ch)) {
                 int prob = p[ch] + Proportion(DetentedIn(ch), HEMISPHERE_MAX_CV, 100);
-                if (random(1, 100) <= prob) {
+                if (Random(1, 100) <= prob) {
                     ClockOut(ch);
                     trigger_countdown[ch] = 1667;
                 }
@@ -117,14 +117,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ClockSkip ClockSkip_instance[2];
+AppletSlot<ClockSkip> ClockSkip_instance;
 
 void ClockSkip_Start(bool hemisphere) {
-    ClockSkip_instance[hemisphere].BaseStart(hemisphere);
+    ClockSkip_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void ClockSkip_Controller(bool hemisphere, bool forwarding) {
-    ClockSkip_instance[hemisphere].BaseController(forwarding);
+    ClockSkip_instance.Controller(hemisphere, forwarding);
 }
 
 void ClockSkip_View(bool hemisphere) {
@@ -109,14 +109,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Compare Compare_instance[2];
+AppletSlot<Compare> Compare_instance;
 
 void Compare_Start(bool hemisphere) {
-    Compare_instance[hemisphere].BaseStart(hemisphere);
+    Compare_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Compare_Controller(bool hemisphere, bool forwarding) {
-    Compare_instance[hemisphere].BaseController(forwarding);
+    Compare_instance.Controller(hemisphere, forwarding);
 }
 
 void Compare_View(bool hemisphere) {
@@ -139,10 +139,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-DrCrusher DrCrusher_instance[2];
+AppletSlot<DrCrusher> DrCrusher_instance;
 
-void DrCrusher_Start(bool hemisphere) {DrCrusher_instance[hemisphere].BaseStart(hemisphere);}
-void DrCrusher_Controller(bool hemisphere, bool forwarding) {DrCrusher_instance[hemisphere].BaseController(forwarding);}
+void DrCrusher_Start(bool hemisphere) {DrCrusher_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void DrCrusher_Controller(bool hemisphere, bool forwarding) {DrCrusher_instance.Controller(hemisphere, forwarding);}
 void DrCrusher_View(bool hemisphere) {DrCrusher_instance[hemisphere].BaseView();}
 void DrCrusher_OnButtonPress(bool hemisphere) {DrCrusher_instance[hemisphere].OnButtonPress();}
 void DrCrusher_OnEncoderMove(bool hemisphere, int direction) {DrCrusher_instance[hemisphere].OnEncoderMove(direction);}
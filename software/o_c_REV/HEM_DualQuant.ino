@@ -36,6 +36,7 @@ public:
         ForEachChannel(ch)
         {
             quantizer[ch].Init();
+            quantizer[ch].EnableTable(quantizer_table[ch]);
             scale[ch] = ch + 5;
             quantizer[ch].Configure(OC::Scales::GetScale(scale[ch]), 0xffff);
             last_note[ch] = 0;
@@ -118,6 +119,7 @@ protected:
     
 private:
     braids::Quantizer quantizer[2];
+    braids::QuantizerTable quantizer_table[2]; // Continuous mode quantizes every tick
     int last_note[2]; // Last quantized note
     bool continuous[2]; // Each channel starts as continuous and becomes clocked when a clock is received
     int cursor;
@@ -166,14 +168,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-DualQuant DualQuant_instance[2];
+AppletSlot<DualQuant> DualQuant_instance;
 
 void DualQuant_Start(bool hemisphere) {
-    DualQuant_instance[hemisphere].BaseStart(hemisphere);
+    DualQuant_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void DualQuant_Controller(bool hemisphere, bool forwarding) {
-    DualQuant_instance[hemisphere].BaseController(forwarding);
+    DualQuant_instance.Controller(hemisphere, forwarding);
 }
 
 void DualQuant_View(bool hemisphere) {
@@ -209,10 +209,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-EnigmaJr EnigmaJr_instance[2];
+AppletSlot<EnigmaJr> EnigmaJr_instance;
 
-void EnigmaJr_Start(bool hemisphere) {EnigmaJr_instance[hemisphere].BaseStart(hemisphere);}
-void EnigmaJr_Controller(bool hemisphere, bool forwarding) {EnigmaJr_instance[hemisphere].BaseController(forwarding);}
+void EnigmaJr_Start(bool hemisphere) {EnigmaJr_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void EnigmaJr_Controller(bool hemisphere, bool forwarding) {EnigmaJr_instance.Controller(hemisphere, forwarding);}
 void EnigmaJr_View(bool hemisphere) {EnigmaJr_instance[hemisphere].BaseView();}
 void EnigmaJr_OnButtonPress(bool hemisphere) {EnigmaJr_instance[hemisphere].OnButtonPress();}
 void EnigmaJr_OnEncoderMove(bool hemisphere, int direction) {EnigmaJr_instance[hemisphere].OnEncoderMove(direction);}
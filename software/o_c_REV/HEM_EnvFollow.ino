@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #define HEM_ENV_FOLLOWER_SAMPLES 166
+#define HEM_ENV_FOLLOWER_BLOCK 16
 
 class EnvFollow : public HemisphereApplet {
 public:
@@ -34,11 +35,11 @@ public:
             gain[ch] = 10;
             duck[ch] = ch; // Default: one of each
         }
-        countdown = HEM_ENV_FOLLOWER_SAMPLES;
+        countdown = HEM_ENV_FOLLOWER_SAMPLES / ControlDecimation();
     }
 
     void Controller() {
-        if (--countdown == 0) {
+        if (ControlTick() && --countdown == 0) {
             ForEachChannel(ch)
             {
                 target[ch] = max[ch] * gain[ch];
@@ -46,12 +47,15 @@ public:
                 target[ch] = constrain(target[ch], 0, HEMISPHERE_MAX_CV);
                 max[ch] = 0;
             }
-            countdown = HEM_ENV_FOLLOWER_SAMPLES;
+            countdown = HEM_ENV_FOLLOWER_SAMPLES / ControlDecimation();
         }
 
         ForEachChannel(ch)
         {
-            if (In(ch) > max[ch]) max[ch] = In(ch);
+            // Peak of every input sample since the last tick, not just the latest
+            int32_t block[HEM_ENV_FOLLOWER_BLOCK];
+            int n = InBlock(ch, block, HEM_ENV_FOLLOWER_BLOCK);
+            for (int i = 0; i < n; i++) if (block[i] > max[ch]) max[ch] = block[i];
             if (target[ch] > signal[ch]) signal[ch]++;
             else if (target[ch] < signal[ch]) signal[ch]--;
             Out(ch, signal[ch]);
@@ -141,10 +145,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-EnvFollow EnvFollow_instance[2];
+AppletSlot<EnvFollow> EnvFollow_instance;
 
-void EnvFollow_Start(bool hemisphere) {EnvFollow_instance[hemisphere].BaseStart(hemisphere);}
-void EnvFollow_Controller(bool hemisphere, bool forwarding) {EnvFollow_instance[hemisphere].BaseController(forwarding);}
+void EnvFollow_Start(bool hemisphere) {EnvFollow_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void EnvFollow_Controller(bool hemisphere, bool forwarding) {EnvFollow_instance.Controller(hemisphere, forwarding);}
 void EnvFollow_View(bool hemisphere) {EnvFollow_instance[hemisphere].BaseView();}
 void EnvFollow_OnButtonPress(bool hemisphere) {EnvFollow_instance[hemisphere].OnButtonPress();}
 void EnvFollow_OnEncoderMove(bool hemisphere, int direction) {EnvFollow_instance[hemisphere].OnEncoderMove(direction);}
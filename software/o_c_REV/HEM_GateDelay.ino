@@ -147,14 +147,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-GateDelay GateDelay_instance[2];
+AppletSlot<GateDelay> GateDelay_instance;
 
 void GateDelay_Start(bool hemisphere) {
-    GateDelay_instance[hemisphere].BaseStart(hemisphere);
+    GateDelay_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void GateDelay_Controller(bool hemisphere, bool forwarding) {
-    GateDelay_instance[hemisphere].BaseController(forwarding);
+    GateDelay_instance.Controller(hemisphere, forwarding);
 }
 
 void GateDelay_View(bool hemisphere) {
@@ -93,14 +93,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-GatedVCA GatedVCA_instance[2];
+AppletSlot<GatedVCA> GatedVCA_instance;
 
 void GatedVCA_Start(bool hemisphere) {
-    GatedVCA_instance[hemisphere].BaseStart(hemisphere);
+    GatedVCA_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void GatedVCA_Controller(bool hemisphere, bool forwarding) {
-    GatedVCA_instance[hemisphere].BaseController(forwarding);
+    GatedVCA_instance.Controller(hemisphere, forwarding);
 }
 
 void GatedVCA_View(bool hemisphere) {
@@ -114,7 +114,7 @@ private:
         int inc = HEM_LOFI_PCM_BUFFER_SIZE / 256;
         int disp[32];
         int high = 1;
-        int pos = head - (inc * 15) - random(1,3); // Try to center the head
+        int pos = head - (inc * 15) - Random(1,3); // Try to center the head
         if (head < 0) head += length;
         for (int i = 0; i < 32; i++)
         {
@@ -174,14 +174,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-LoFiPCM LoFiPCM_instance[2];
+AppletSlot<LoFiPCM> LoFiPCM_instance;
 
 void LoFiPCM_Start(bool hemisphere) {
-    LoFiPCM_instance[hemisphere].BaseStart(hemisphere);
+    LoFiPCM_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void LoFiPCM_Controller(bool hemisphere, bool forwarding) {
-    LoFiPCM_instance[hemisphere].BaseController(forwarding);
+    LoFiPCM_instance.Controller(hemisphere, forwarding);
 }
 
 void LoFiPCM_View(bool hemisphere) {
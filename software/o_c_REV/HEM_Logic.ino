@@ -151,14 +151,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Logic Logic_instance[2];
+AppletSlot<Logic> Logic_instance;
 
 void Logic_Start(bool hemisphere) {
-    Logic_instance[hemisphere].BaseStart(hemisphere);
+    Logic_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Logic_Controller(bool hemisphere, bool forwarding) {
-    Logic_instance[hemisphere].BaseController(forwarding);
+    Logic_instance.Controller(hemisphere, forwarding);
 }
 
 void Logic_View(bool hemisphere) {
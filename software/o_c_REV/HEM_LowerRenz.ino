@@ -38,7 +38,11 @@ public:
     }
 
     void Controller() {
-        if (!Gate(1)) { // Freeze if gated
+        if (Gate(1)) return; // Freeze if gated
+        if (Clock(0, true)) lorenz_m->Reset(hemisphere);
+
+        // The generator is processed every LORENZ_PROCESS_TICKS, which is this applet's decimation
+        if (ControlTick()) {
             int freq_cv = Proportion(In(0), HEMISPHERE_MAX_CV, 63);
             int rho_cv = Proportion(In(1), HEMISPHERE_MAX_CV, 31);
 
@@ -49,7 +53,6 @@ public:
             int32_t rho_h = SCALE8_16(constrain(rho + rho_cv, 4, 127));
             lorenz_m->SetRho(hemisphere, USAT16(rho_h));
 
-            if (Clock(0, true)) lorenz_m->Reset(hemisphere);
             lorenz_m->Process();
 
             // The scaling here is based on observation of the value range
@@ -135,14 +138,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-LowerRenz LowerRenz_instance[2];
+AppletSlot<LowerRenz> LowerRenz_instance;
 
 void LowerRenz_Start(bool hemisphere) {
-    LowerRenz_instance[hemisphere].BaseStart(hemisphere);
+    LowerRenz_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void LowerRenz_Controller(bool hemisphere, bool forwarding) {
-    LowerRenz_instance[hemisphere].BaseController(forwarding);
+    LowerRenz_instance.Controller(hemisphere, forwarding);
 }
 
 void LowerRenz_View(bool hemisphere) {
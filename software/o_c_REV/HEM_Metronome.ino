@@ -51,18 +51,19 @@ public:
     void OnEncoderMove(int direction) {
         uint16_t bpm = clock_m->GetTempo();
         bpm += direction;
-        clock_m->SetTempoBPM(bpm);
+        clock_m->SetTempoBPM(bpm, clock_m->GetTempoHundredths());
     }
         
     uint32_t OnDataRequest() {
         uint32_t data = 0;
         Pack(data, PackLocation {0,16}, clock_m->GetTempo());
         Pack(data, PackLocation {16,5}, clock_m->GetMultiply() - 1);
+        Pack(data, PackLocation {21,7}, clock_m->GetTempoHundredths());
         return data;
     }
 
     void OnDataReceive(uint32_t data) {
-        clock_m->SetTempoBPM(Unpack(data, PackLocation {0,16}));
+        clock_m->SetTempoBPM(Unpack(data, PackLocation {0,16}), Unpack(data, PackLocation {21,7}));
         clock_m->SetMultiply(Unpack(data, PackLocation {16,5}) + 1);
     }
 
@@ -122,10 +123,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Metronome Metronome_instance[2];
+AppletSlot<Metronome> Metronome_instance;
 
-void Metronome_Start(bool hemisphere) {Metronome_instance[hemisphere].BaseStart(hemisphere);}
-void Metronome_Controller(bool hemisphere, bool forwarding) {Metronome_instance[hemisphere].BaseController(forwarding);}
+void Metronome_Start(bool hemisphere) {Metronome_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void Metronome_Controller(bool hemisphere, bool forwarding) {Metronome_instance.Controller(hemisphere, forwarding);}
 void Metronome_View(bool hemisphere) {Metronome_instance[hemisphere].BaseView();}
 void Metronome_OnButtonPress(bool hemisphere) {Metronome_instance[hemisphere].OnButtonPress();}
 void Metronome_OnEncoderMove(bool hemisphere, int direction) {Metronome_instance[hemisphere].OnEncoderMove(direction);}
@@ -98,14 +98,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-MixerBal MixerBal_instance[2];
+AppletSlot<MixerBal> MixerBal_instance;
 
 void MixerBal_Start(bool hemisphere) {
-    MixerBal_instance[hemisphere].BaseStart(hemisphere);
+    MixerBal_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void MixerBal_Controller(bool hemisphere, bool forwarding) {
-    MixerBal_instance[hemisphere].BaseController(forwarding);
+    MixerBal_instance.Controller(hemisphere, forwarding);
 }
 
 void MixerBal_View(bool hemisphere) {
@@ -175,14 +175,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Palimpsest Palimpsest_instance[2];
+AppletSlot<Palimpsest> Palimpsest_instance;
 
 void Palimpsest_Start(bool hemisphere) {
-    Palimpsest_instance[hemisphere].BaseStart(hemisphere);
+    Palimpsest_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Palimpsest_Controller(bool hemisphere, bool forwarding) {
-    Palimpsest_instance[hemisphere].BaseController(forwarding);
+    Palimpsest_instance.Controller(hemisphere, forwarding);
 }
 
 void Palimpsest_View(bool hemisphere) {
@@ -94,10 +94,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-RunglBook RunglBook_instance[2];
+AppletSlot<RunglBook> RunglBook_instance;
 
-void RunglBook_Start(bool hemisphere) {RunglBook_instance[hemisphere].BaseStart(hemisphere);}
-void RunglBook_Controller(bool hemisphere, bool forwarding) {RunglBook_instance[hemisphere].BaseController(forwarding);}
+void RunglBook_Start(bool hemisphere) {RunglBook_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void RunglBook_Controller(bool hemisphere, bool forwarding) {RunglBook_instance.Controller(hemisphere, forwarding);}
 void RunglBook_View(bool hemisphere) {RunglBook_instance[hemisphere].BaseView();}
 void RunglBook_OnButtonPress(bool hemisphere) {RunglBook_instance[hemisphere].OnButtonPress();}
 void RunglBook_OnEncoderMove(bool hemisphere, int direction) {RunglBook_instance[hemisphere].OnEncoderMove(direction);}
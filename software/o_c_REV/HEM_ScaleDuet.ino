@@ -37,6 +37,7 @@ public:
             mask[scale] = 0xffff;
         }
         quantizer.Init();
+        quantizer.EnableTable(quantizer_table);
         quantizer.Configure(OC::Scales::GetScale(5), mask[0]);
         last_scale = 0;
         adc_lag_countdown = 0;
@@ -107,6 +108,7 @@ protected:
     
 private:
     braids::Quantizer quantizer;
+    braids::QuantizerTable quantizer_table;
     uint16_t mask[2];
     uint8_t cursor; // 0-11=Scale 1; 12-23=Scale 2
     uint8_t last_scale; // The most-recently-used scale (used to set the mask when necessary)
@@ -160,14 +162,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ScaleDuet ScaleDuet_instance[2];
+AppletSlot<ScaleDuet> ScaleDuet_instance;
 
 void ScaleDuet_Start(bool hemisphere) {
-    ScaleDuet_instance[hemisphere].BaseStart(hemisphere);
+    ScaleDuet_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void ScaleDuet_Controller(bool hemisphere, bool forwarding) {
-    ScaleDuet_instance[hemisphere].BaseController(forwarding);
+    ScaleDuet_instance.Controller(hemisphere, forwarding);
 }
 
 void ScaleDuet_View(bool hemisphere) {
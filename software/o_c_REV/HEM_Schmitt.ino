@@ -159,14 +159,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Schmitt Schmitt_instance[2];
+AppletSlot<Schmitt> Schmitt_instance;
 
 void Schmitt_Start(bool hemisphere) {
-    Schmitt_instance[hemisphere].BaseStart(hemisphere);
+    Schmitt_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Schmitt_Controller(bool hemisphere, bool forwarding) {
-    Schmitt_instance[hemisphere].BaseController(forwarding);
+    Schmitt_instance.Controller(hemisphere, forwarding);
 }
 
 void Schmitt_View(bool hemisphere) {
@@ -169,14 +169,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Scope Scope_instance[2];
+AppletSlot<Scope> Scope_instance;
 
 void Scope_Start(bool hemisphere) {
-    Scope_instance[hemisphere].BaseStart(hemisphere);
+    Scope_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Scope_Controller(bool hemisphere, bool forwarding) {
-    Scope_instance[hemisphere].BaseController(forwarding);
+    Scope_instance.Controller(hemisphere, forwarding);
 }
 
 void Scope_View(bool hemisphere) {
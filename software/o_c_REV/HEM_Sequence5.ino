@@ -28,7 +28,7 @@ public:
     }
 
     void Start() {
-        for (int s = 0; s < 5; s++) note[s] = random(0, 30);
+        for (int s = 0; s < 5; s++) note[s] = Random(0, 30);
         play = 1;
     }
 
@@ -158,14 +158,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Sequence5 Sequence5_instance[2];
+AppletSlot<Sequence5> Sequence5_instance;
 
 void Sequence5_Start(bool hemisphere) {
-    Sequence5_instance[hemisphere].BaseStart(hemisphere);
+    Sequence5_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Sequence5_Controller(bool hemisphere, bool forwarding) {
-    Sequence5_instance[hemisphere].BaseController(forwarding);
+    Sequence5_instance.Controller(hemisphere, forwarding);
 }
 
 void Sequence5_View(bool hemisphere) {
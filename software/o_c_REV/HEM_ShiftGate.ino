@@ -10,7 +10,7 @@ public:
         {
             length[ch] = 4;
             trigger[ch] = ch;
-            reg[ch] = random(0, 0xffff);
+            reg[ch] = Random(0, 0xffff);
         }
     }
 
@@ -130,10 +130,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ShiftGate ShiftGate_instance[2];
+AppletSlot<ShiftGate> ShiftGate_instance;
 
-void ShiftGate_Start(bool hemisphere) {ShiftGate_instance[hemisphere].BaseStart(hemisphere);}
-void ShiftGate_Controller(bool hemisphere, bool forwarding) {ShiftGate_instance[hemisphere].BaseController(forwarding);}
+void ShiftGate_Start(bool hemisphere) {ShiftGate_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void ShiftGate_Controller(bool hemisphere, bool forwarding) {ShiftGate_instance.Controller(hemisphere, forwarding);}
 void ShiftGate_View(bool hemisphere) {ShiftGate_instance[hemisphere].BaseView();}
 void ShiftGate_OnButtonPress(bool hemisphere) {ShiftGate_instance[hemisphere].OnButtonPress();}
 void ShiftGate_OnEncoderMove(bool hemisphere, int direction) {ShiftGate_instance[hemisphere].OnEncoderMove(direction);}
@@ -138,7 +138,8 @@ private:
             gfxBitmap(x, 48 - (which == n ? 3 : 0), 8, which == n ? NOTE_ICON : X_NOTE_ICON);
         }
 
-        int lx = Proportion(OC::CORE::ticks - last_tick, tempo, 20) + (which * 20) + 4;
+        // No tempo until the second clock
+        int lx = (tempo ? Proportion(OC::CORE::ticks - last_tick, tempo, 20) : 0) + (which * 20) + 4;
         lx = constrain(lx, 1, 54);
         gfxDottedLine(lx, 42, lx, 60, 2);
     }
@@ -153,14 +154,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Shuffle Shuffle_instance[2];
+AppletSlot<Shuffle> Shuffle_instance;
 
 void Shuffle_Start(bool hemisphere) {
-    Shuffle_instance[hemisphere].BaseStart(hemisphere);
+    Shuffle_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Shuffle_Controller(bool hemisphere, bool forwarding) {
-    Shuffle_instance[hemisphere].BaseController(forwarding);
+    Shuffle_instance.Controller(hemisphere, forwarding);
 }
 
 void Shuffle_View(bool hemisphere) {
@@ -164,14 +164,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-SkewedLFO SkewedLFO_instance[2];
+AppletSlot<SkewedLFO> SkewedLFO_instance;
 
 void SkewedLFO_Start(bool hemisphere) {
-    SkewedLFO_instance[hemisphere].BaseStart(hemisphere);
+    SkewedLFO_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void SkewedLFO_Controller(bool hemisphere, bool forwarding) {
-    SkewedLFO_instance[hemisphere].BaseController(forwarding);
+    SkewedLFO_instance.Controller(hemisphere, forwarding);
 }
 
 void SkewedLFO_View(bool hemisphere) {
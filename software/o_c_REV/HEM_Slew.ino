@@ -151,14 +151,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Slew Slew_instance[2];
+AppletSlot<Slew> Slew_instance;
 
 void Slew_Start(bool hemisphere) {
-    Slew_instance[hemisphere].BaseStart(hemisphere);
+    Slew_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Slew_Controller(bool hemisphere, bool forwarding) {
-    Slew_instance[hemisphere].BaseController(forwarding);
+    Slew_instance.Controller(hemisphere, forwarding);
 }
 
 void Slew_View(bool hemisphere) {
@@ -33,6 +33,7 @@ public:
 
     void Start() {
         quantizer.Init();
+        quantizer.EnableTable(quantizer_table);
         scale = 5;
         quantizer.Configure(OC::Scales::GetScale(scale), 0xffff);
     }
@@ -111,6 +112,7 @@ private:
     bool continuous = 1;
     int last_note[2]; // Last quantized note
     braids::Quantizer quantizer;
+    braids::QuantizerTable quantizer_table;
 
     // Settings
     int scale;
@@ -166,10 +168,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Squanch Squanch_instance[2];
+AppletSlot<Squanch> Squanch_instance;
 
-void Squanch_Start(bool hemisphere) {Squanch_instance[hemisphere].BaseStart(hemisphere);}
-void Squanch_Controller(bool hemisphere, bool forwarding) {Squanch_instance[hemisphere].BaseController(forwarding);}
+void Squanch_Start(bool hemisphere) {Squanch_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void Squanch_Controller(bool hemisphere, bool forwarding) {Squanch_instance.Controller(hemisphere, forwarding);}
 void Squanch_View(bool hemisphere) {Squanch_instance[hemisphere].BaseView();}
 void Squanch_OnButtonPress(bool hemisphere) {Squanch_instance[hemisphere].OnButtonPress();}
 void Squanch_OnEncoderMove(bool hemisphere, int direction) {Squanch_instance[hemisphere].OnEncoderMove(direction);}
@@ -107,14 +107,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Switch Switch_instance[2];
+AppletSlot<Switch> Switch_instance;
 
 void Switch_Start(bool hemisphere) {
-    Switch_instance[hemisphere].BaseStart(hemisphere);
+    Switch_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Switch_Controller(bool hemisphere, bool forwarding) {
-    Switch_instance[hemisphere].BaseController(forwarding);
+    Switch_instance.Controller(hemisphere, forwarding);
 }
 
 void Switch_View(bool hemisphere) {
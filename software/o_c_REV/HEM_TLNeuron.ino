@@ -164,14 +164,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TLNeuron TLNeuron_instance[2];
+AppletSlot<TLNeuron> TLNeuron_instance;
 
 void TLNeuron_Start(bool hemisphere) {
-    TLNeuron_instance[hemisphere].BaseStart(hemisphere);
+    TLNeuron_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void TLNeuron_Controller(bool hemisphere, bool forwarding) {
-    TLNeuron_instance[hemisphere].BaseController(forwarding);
+    TLNeuron_instance.Controller(hemisphere, forwarding);
 }
 
 void TLNeuron_View(bool hemisphere) {
@@ -42,7 +42,7 @@ public:
     }
 
     void Start() {
-        reg = random(0, 65535);
+        reg = Random(0, 65535);
         p = 0;
         length = 16;
         cursor = 0;
@@ -72,7 +72,7 @@ public:
             int last = (reg >> (length - 1)) & 0x01;
 
             // Does it change?
-            if (random(0, 99) < prob) last = 1 - last;
+            if (Random(0, 99) < prob) last = 1 - last;
 
             // Shift left, then potentially add the bit from the other side
             reg = (reg << 1) + last;
@@ -176,7 +176,7 @@ private:
     void AdvanceRegister(int prob) {
         // Before shifting, determine the fate of the last bit
         int last = (reg >> 15) & 0x01;
-        if (random(0, 99) < prob) last = 1 - last;
+        if (Random(0, 99) < prob) last = 1 - last;
 
         // Shift left, then potentially add the bit from the other side
         reg = (reg << 1) + last;
@@ -193,14 +193,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TM TM_instance[2];
+AppletSlot<TM> TM_instance;
 
 void TM_Start(bool hemisphere) {
-    TM_instance[hemisphere].BaseStart(hemisphere);
+    TM_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void TM_Controller(bool hemisphere, bool forwarding) {
-    TM_instance[hemisphere].BaseController(forwarding);
+    TM_instance.Controller(hemisphere, forwarding);
 }
 
 void TM_View(bool hemisphere) {
@@ -47,9 +47,10 @@ public:
     }
 
     void Controller() {
-        if (--sample_countdown < 0) {
-            sample_countdown = (TRENDING_MAX_SENS - sensitivity) * 20;
-            if (sample_countdown < 96) sample_countdown = 96;
+        // The sample countdown is in control ticks
+        if (ControlTick() && --sample_countdown < 0) {
+            sample_countdown = (TRENDING_MAX_SENS - sensitivity) * 20 / ControlDecimation();
+            if (sample_countdown < 96 / ControlDecimation()) sample_countdown = 96 / ControlDecimation();
 
             ForEachChannel(ch)
             {
@@ -192,10 +193,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Trending Trending_instance[2];
+AppletSlot<Trending> Trending_instance;
 
-void Trending_Start(bool hemisphere) {Trending_instance[hemisphere].BaseStart(hemisphere);}
-void Trending_Controller(bool hemisphere, bool forwarding) {Trending_instance[hemisphere].BaseController(forwarding);}
+void Trending_Start(bool hemisphere) {Trending_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void Trending_Controller(bool hemisphere, bool forwarding) {Trending_instance.Controller(hemisphere, forwarding);}
 void Trending_View(bool hemisphere) {Trending_instance[hemisphere].BaseView();}
 void Trending_OnButtonPress(bool hemisphere) {Trending_instance[hemisphere].OnButtonPress();}
 void Trending_OnEncoderMove(bool hemisphere, int direction) {Trending_instance[hemisphere].OnEncoderMove(direction);}
@@ -28,7 +28,7 @@ public:
     void Start() {
         ForEachChannel(ch)
         {
-            pattern[ch] = random(1, 255);
+            pattern[ch] = Random(1, 255);
             end_step[ch] = 7;
             step[ch] = 0;
         }
@@ -167,14 +167,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TrigSeq TrigSeq_instance[2];
+AppletSlot<TrigSeq> TrigSeq_instance;
 
 void TrigSeq_Start(bool hemisphere) {
-    TrigSeq_instance[hemisphere].BaseStart(hemisphere);
+    TrigSeq_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void TrigSeq_Controller(bool hemisphere, bool forwarding) {
-    TrigSeq_instance[hemisphere].BaseController(forwarding);
+    TrigSeq_instance.Controller(hemisphere, forwarding);
 }
 
 void TrigSeq_View(bool hemisphere) {
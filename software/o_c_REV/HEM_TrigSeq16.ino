@@ -28,7 +28,7 @@ public:
     void Start() {
         ForEachChannel(ch)
         {
-            pattern[ch] = random(1, 255);
+            pattern[ch] = Random(1, 255);
         }
         step = 0;
         end_step = 15;
@@ -170,14 +170,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TrigSeq16 TrigSeq16_instance[2];
+AppletSlot<TrigSeq16> TrigSeq16_instance;
 
 void TrigSeq16_Start(bool hemisphere) {
-    TrigSeq16_instance[hemisphere].BaseStart(hemisphere);
+    TrigSeq16_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void TrigSeq16_Controller(bool hemisphere, bool forwarding) {
-    TrigSeq16_instance[hemisphere].BaseController(forwarding);
+    TrigSeq16_instance.Controller(hemisphere, forwarding);
 }
 
 void TrigSeq16_View(bool hemisphere) {
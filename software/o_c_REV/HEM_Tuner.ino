@@ -218,14 +218,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Tuner Tuner_instance[2];
+AppletSlot<Tuner> Tuner_instance;
 
 void Tuner_Start(bool hemisphere) {
-    Tuner_instance[hemisphere].BaseStart(hemisphere);
+    Tuner_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void Tuner_Controller(bool hemisphere, bool forwarding) {
-    Tuner_instance[hemisphere].BaseController(forwarding);
+    Tuner_instance.Controller(hemisphere, forwarding);
 }
 
 void Tuner_View(bool hemisphere) {
@@ -187,10 +187,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-VectorEG VectorEG_instance[2];
+AppletSlot<VectorEG> VectorEG_instance;
 
-void VectorEG_Start(bool hemisphere) {VectorEG_instance[hemisphere].BaseStart(hemisphere);}
-void VectorEG_Controller(bool hemisphere, bool forwarding) {VectorEG_instance[hemisphere].BaseController(forwarding);}
+void VectorEG_Start(bool hemisphere) {VectorEG_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void VectorEG_Controller(bool hemisphere, bool forwarding) {VectorEG_instance.Controller(hemisphere, forwarding);}
 void VectorEG_View(bool hemisphere) {VectorEG_instance[hemisphere].BaseView();}
 void VectorEG_OnButtonPress(bool hemisphere) {VectorEG_instance[hemisphere].OnButtonPress();}
 void VectorEG_OnEncoderMove(bool hemisphere, int direction) {VectorEG_instance[hemisphere].OnEncoderMove(direction);}
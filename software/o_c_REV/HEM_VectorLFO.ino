@@ -216,10 +216,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-VectorLFO VectorLFO_instance[2];
+AppletSlot<VectorLFO> VectorLFO_instance;
 
-void VectorLFO_Start(bool hemisphere) {VectorLFO_instance[hemisphere].BaseStart(hemisphere);}
-void VectorLFO_Controller(bool hemisphere, bool forwarding) {VectorLFO_instance[hemisphere].BaseController(forwarding);}
+void VectorLFO_Start(bool hemisphere) {VectorLFO_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void VectorLFO_Controller(bool hemisphere, bool forwarding) {VectorLFO_instance.Controller(hemisphere, forwarding);}
 void VectorLFO_View(bool hemisphere) {VectorLFO_instance[hemisphere].BaseView();}
 void VectorLFO_OnButtonPress(bool hemisphere) {VectorLFO_instance[hemisphere].OnButtonPress();}
 void VectorLFO_OnEncoderMove(bool hemisphere, int direction) {VectorLFO_instance[hemisphere].OnEncoderMove(direction);}
@@ -179,10 +179,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-VectorMod VectorMod_instance[2];
+AppletSlot<VectorMod> VectorMod_instance;
 
-void VectorMod_Start(bool hemisphere) {VectorMod_instance[hemisphere].BaseStart(hemisphere);}
-void VectorMod_Controller(bool hemisphere, bool forwarding) {VectorMod_instance[hemisphere].BaseController(forwarding);}
+void VectorMod_Start(bool hemisphere) {VectorMod_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void VectorMod_Controller(bool hemisphere, bool forwarding) {VectorMod_instance.Controller(hemisphere, forwarding);}
 void VectorMod_View(bool hemisphere) {VectorMod_instance[hemisphere].BaseView();}
 void VectorMod_OnButtonPress(bool hemisphere) {VectorMod_instance[hemisphere].OnButtonPress();}
 void VectorMod_OnEncoderMove(bool hemisphere, int direction) {VectorMod_instance[hemisphere].OnEncoderMove(direction);}
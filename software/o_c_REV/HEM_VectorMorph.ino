@@ -180,10 +180,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-VectorMorph VectorMorph_instance[2];
+AppletSlot<VectorMorph> VectorMorph_instance;
 
-void VectorMorph_Start(bool hemisphere) {VectorMorph_instance[hemisphere].BaseStart(hemisphere);}
-void VectorMorph_Controller(bool hemisphere, bool forwarding) {VectorMorph_instance[hemisphere].BaseController(forwarding);}
+void VectorMorph_Start(bool hemisphere) {VectorMorph_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void VectorMorph_Controller(bool hemisphere, bool forwarding) {VectorMorph_instance.Controller(hemisphere, forwarding);}
 void VectorMorph_View(bool hemisphere) {VectorMorph_instance[hemisphere].BaseView();}
 void VectorMorph_OnButtonPress(bool hemisphere) {VectorMorph_instance[hemisphere].OnButtonPress();}
 void VectorMorph_OnEncoderMove(bool hemisphere, int direction) {VectorMorph_instance[hemisphere].OnEncoderMove(direction);}
@@ -133,10 +133,10 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Voltage Voltage_instance[2];
+AppletSlot<Voltage> Voltage_instance;
 
-void Voltage_Start(bool hemisphere) {Voltage_instance[hemisphere].BaseStart(hemisphere);}
-void Voltage_Controller(bool hemisphere, bool forwarding) {Voltage_instance[hemisphere].BaseController(forwarding);}
+void Voltage_Start(bool hemisphere) {Voltage_instance.Construct(hemisphere).BaseStart(hemisphere);}
+void Voltage_Controller(bool hemisphere, bool forwarding) {Voltage_instance.Controller(hemisphere, forwarding);}
 void Voltage_View(bool hemisphere) {Voltage_instance[hemisphere].BaseView();}
 void Voltage_OnButtonPress(bool hemisphere) {Voltage_instance[hemisphere].OnButtonPress();}
 void Voltage_OnEncoderMove(bool hemisphere, int direction) {Voltage_instance[hemisphere].OnEncoderMove(direction);}
@@ -71,12 +71,11 @@ public:
     }
 
     void Controller() {
-        if (usbMIDI.read()) {
-            int message = usbMIDI.getType();
-            int data1 = usbMIDI.getData1();
-            int data2 = usbMIDI.getData2();
-
-            if (message == HEM_MIDI_SYSEX) ReceiveManagerSysEx();
+        OC::MidiEvent event;
+        while (midi_events.Read(event)) {
+            int message = event.type;
+            int data1 = event.data1;
+            int data2 = event.data2;
 
             // Listen for incoming clock
             if (message == HEM_MIDI_REALTIME && data1 == 0) {
@@ -91,7 +90,7 @@ public:
                 if (clock_count == HEM_MIDI_CLOCK_DIVISOR) clock_count = 0;
             }
 
-            if (usbMIDI.getChannel() == (channel + 1)) {
+            if (event.channel == (channel + 1)) {
                 last_tick = OC::CORE::ticks;
                 bool log_this = false;
 
@@ -229,6 +228,7 @@ private:
     int first_note; // First note received, for awaiting Note Off
     const char* fn_name[8];
     uint8_t clock_count; // MIDI clock counter (24ppqn)
+    OC::MidiSubscriber midi_events {OC::MidiInput::kAllTypes & ~OC::MidiInput::type_mask(HEM_MIDI_SYSEX)};
     
     // Logging
     MIDILogEntry log[7];
@@ -323,14 +323,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-hMIDIIn hMIDIIn_instance[2];
+AppletSlot<hMIDIIn> hMIDIIn_instance;
 
 void hMIDIIn_Start(bool hemisphere) {
-    hMIDIIn_instance[hemisphere].BaseStart(hemisphere);
+    hMIDIIn_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void hMIDIIn_Controller(bool hemisphere, bool forwarding) {
-    hMIDIIn_instance[hemisphere].BaseController(forwarding);
+    hMIDIIn_instance.Controller(hemisphere, forwarding);
 }
 
 void hMIDIIn_View(bool hemisphere) {
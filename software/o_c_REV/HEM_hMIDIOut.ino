@@ -290,14 +290,14 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-hMIDIOut hMIDIOut_instance[2];
+AppletSlot<hMIDIOut> hMIDIOut_instance;
 
 void hMIDIOut_Start(bool hemisphere) {
-    hMIDIOut_instance[hemisphere].BaseStart(hemisphere);
+    hMIDIOut_instance.Construct(hemisphere).BaseStart(hemisphere);
 }
 
 void hMIDIOut_Controller(bool hemisphere, bool forwarding) {
-    hMIDIOut_instance[hemisphere].BaseController(forwarding);
+    hMIDIOut_instance.Controller(hemisphere, forwarding);
 }
 
 void hMIDIOut_View(bool hemisphere) {
@@ -32,6 +32,7 @@ typedef int32_t simfloat;
 #endif
 
 #include "HSicons.h"
+#include "OC_random.h"
 
 #ifndef HSAPPLICATION_H_
 #define HSAPPLICATION_H_
@@ -98,6 +99,11 @@ public:
         return scaled;
     }
 
+    // [min, max) from the shared generator, like Arduino random(min, max) but without the division
+    int Random(int min, int max) {
+        return OC::random_source.Range(min, max);
+    }
+
     //////////////// Hemisphere-like IO methods
     ////////////////////////////////////////////////////////////////////////////////
     void Out(int ch, int value, int octave = 0) {
@@ -19,39 +19,100 @@
 // SOFTWARE.
 
 // A "tick" is one ISR cycle, which happens 16666.667 times per second, or a million
-// times per minute. A "tock" is a metronome beat.
+// times per minute. A "tock" is a metronome beat, or a division of one when multiplied.
+//
+// The clock runs at the set tempo, or follows MIDI clock through the PLL in OC::midi_input.
 
 #ifndef CLOCK_MANAGER_H
 #define CLOCK_MANAGER_H
 
+#include "OC_midi_input.h"
+#include "util/util_clock_phase.h"
+
 const uint16_t CLOCK_TEMPO_MIN = 10;
 const uint16_t CLOCK_TEMPO_MAX = 300;
+const uint8_t CLOCK_SWING_MIN = 50;
+const uint8_t CLOCK_SWING_MAX = 75;
 
 class ClockManager {
+    typedef util::ClockPhase<60000000UL / OC_CORE_TIMER_RATE> Phase;
+
     static ClockManager *instance;
-    uint32_t ticks_per_tock; // Based on the selected tempo in BPM
-    uint32_t last_tock_tick; // The tick of the most recent tock
-    uint32_t last_tock_check; // To avoid checking the tock more than once per tick
-    bool tock; // The most recent tock value
-    uint16_t tempo; // The set tempo, for display somewhere else
+    Phase phase; // Advanced by Tick(), to the current tick
+    uint32_t last_tick; // The tick of the latest Tick()
+    bool tock; // Whether this tick has a tock
+    uint16_t tempo; // The set tempo in BPM, for display somewhere else
+    uint8_t tempo_hundredths; // and the fraction of a BPM
+    uint8_t swing; // Percent of a pair of tocks before the second one
     bool running; // Specifies whether the clock is running for interprocess communication
     bool paused; // Specifies whethr the clock is paused
     int8_t tocks_per_beat; // Multiplier
-    bool cycle; // Alternates for each tock, for display purposes
+    bool cycle; // Alternates for each beat, for display purposes
     byte count; // Multiple counter
     bool forwarded; // Master clock forwarding is enabled when true
+    bool midi_sync; // Follows MIDI clock instead of the set tempo when true
+    uint32_t midi_sequence; // The latest MIDI clock pulse followed
+    bool midi_following; // The phase was steered at the latest pulse
 
     ClockManager() {
+        phase.Init();
+        last_tick = OC::CORE::ticks;
+        tocks_per_beat = 1;
         SetTempoBPM(120);
-        SetMultiply(1);
+        SetSwing(CLOCK_SWING_MIN);
         running = 0;
         paused = 0;
         cycle = 0;
-        last_tock_tick = 0;
-        last_tock_check = 0;
         count = 0;
         tock = 0;
         forwarded = 0;
+        midi_sync = 0;
+        midi_sequence = 0;
+        midi_following = 0;
+    }
+
+    /* Steers the phase so that it reaches the next MIDI clock pulse's position at the PLL's
+     * estimate of its time. Pulses 0-47 since MIDI Start span two beats, which are a whole
+     * number of pairs of tocks at any multiplier. This is once per pulse; between pulses the
+     * tick is as usual. Returns false when the clock should hold, because MIDI clock has stopped.
+     */
+    bool FollowMidi() {
+        const util::ClockPll &pll = OC::midi_input.clock();
+        bool pulse = pll.sequence() != midi_sequence;
+        midi_sequence = pll.sequence();
+
+        // Pulse 0 is a tock even before the PLL has a tempo
+        bool start = pulse && pll.index() == 0;
+        if (start) Reset();
+        if (!pll.running(OC::CORE::ticks)) {
+            phase.SetIncrement(0);
+            midi_following = 0;
+            return start;
+        }
+        if (!pulse) return 1;
+
+        // Joining, the phase moves to the pulse rather than catching up with it
+        const uint64_t beat_phase = static_cast<uint64_t>(Phase::kTockPhase) * tocks_per_beat;
+        const uint32_t pulse_index = pll.index() % 48;
+        if (!start && !midi_following) phase.Sync((pulse_index * beat_phase / 24) % Phase::kPairPhase);
+        midi_following = 1;
+
+        const uint32_t target = ((pulse_index + 1) * beat_phase / 24) % Phase::kPairPhase;
+        const uint32_t current = phase.phase() % Phase::kPairPhase;
+        const uint32_t distance = target >= current ? target - current : target + Phase::kPairPhase - current;
+        int32_t remaining = static_cast<int32_t>(pll.period()) + pll.offset();
+        if (remaining < (1 << util::ClockPll::kShift)) remaining = 1 << util::ClockPll::kShift;
+
+        // Past the target, it waits for the next pulse
+        if (distance > Phase::kPairPhase / 4 * 3) phase.SetIncrement(0);
+        else phase.SetIncrement((static_cast<uint64_t>(distance) << util::ClockPll::kShift) / remaining);
+
+        // The followed tempo, for display
+        uint32_t hundredths = (static_cast<uint64_t>(Phase::kTockPhase) << util::ClockPll::kShift) / (24ULL * pll.period());
+        hundredths = constrain(hundredths, CLOCK_TEMPO_MIN * 100, CLOCK_TEMPO_MAX * 100);
+        tempo = hundredths / 100;
+        tempo_hundredths = hundredths % 100;
+        return 1;
     }
 
 public:
@@ -63,16 +124,23 @@ public:
     void SetMultiply(int8_t multiply) {
         multiply = constrain(multiply, 1, 24);
         tocks_per_beat = multiply;
+        if (count >= tocks_per_beat) count = 0;
+        phase.SetRate(tempo * 100 + tempo_hundredths, tocks_per_beat);
     }
 
-    /* Set ticks per tock, based on one million ticks per minute divided by beats per minute.
-     * This is approximate, because the arithmetical value is likely to be fractional, and we
-     * need to live with a certain amount of imprecision here. So I'm not even rounding up.
+    /* Sets the tempo to bpm + hundredths / 100. The phase carries over, so a tempo change takes
+     * effect from the current tock.
      */
-    void SetTempoBPM(uint16_t bpm) {
-        bpm = constrain(bpm, CLOCK_TEMPO_MIN, CLOCK_TEMPO_MAX);
-        ticks_per_tock = 1000000 / bpm;
-        tempo = bpm;
+    void SetTempoBPM(uint16_t bpm, uint8_t hundredths = 0) {
+        if (bpm < CLOCK_TEMPO_MIN || bpm >= CLOCK_TEMPO_MAX) hundredths = 0;
+        tempo = constrain(bpm, CLOCK_TEMPO_MIN, CLOCK_TEMPO_MAX);
+        tempo_hundredths = hundredths < 100 ? hundredths : 99;
+        phase.SetRate(tempo * 100 + tempo_hundredths, tocks_per_beat);
+    }
+
+    void SetSwing(uint8_t percent) {
+        swing = constrain(percent, CLOCK_SWING_MIN, CLOCK_SWING_MAX);
+        phase.SetSwing(swing);
     }
 
     int8_t GetMultiply() {return tocks_per_beat;}
@@ -82,15 +150,20 @@ public:
      */
     uint16_t GetTempo() {return tempo;}
 
+    uint8_t GetTempoHundredths() {return tempo_hundredths;}
+
+    uint8_t GetSwing() {return swing;}
+
+    /* The next tick starts a beat */
     void Reset() {
-        last_tock_tick = OC::CORE::ticks;
+        phase.Reset();
         count = 0;
-        cycle = 1 - cycle;
     }
 
     void Start() {
         forwarded = 0;
         running = 1;
+        Reset();
         Unpause();
     }
 
@@ -105,26 +178,44 @@ public:
 
     void ToggleForwarding() {forwarded = 1 - forwarded;}
 
+    /* Follows MIDI clock, or goes back to the set tempo (the last one followed) */
+    void SetMidiSync(bool sync) {
+        if (midi_sync && !sync) SetTempoBPM(tempo, tempo_hundredths);
+        midi_sync = sync;
+        midi_sequence = OC::midi_input.clock().sequence();
+        midi_following = 0;
+    }
+
+    bool IsMidiSync() {return midi_sync;}
+
+    bool IsMidiLocked() {return midi_sync && OC::midi_input.clock().locked(OC::CORE::ticks);}
+
     bool IsRunning() {return (running && !paused);}
 
     bool IsPaused() {return paused;}
 
     bool IsForwarded() {return forwarded;}
 
-    /* Returns true if the clock should fire on this tick, based on the current tempo */
-    bool Tock() {
-        uint32_t now = OC::CORE::ticks;
-        if (now != last_tock_check) {
-            last_tock_check = now;
-            if (now >= (last_tock_tick + (ticks_per_tock / static_cast<uint32_t>(tocks_per_beat)))) {
-                tock = 1;
-                last_tock_tick = now;
-                if (++count >= tocks_per_beat) Reset();
-            } else tock = 0;
+    /* Advances the clock to the current tick. Called once per ISR, before the applets' controllers.
+     * The app's ISR is held off at times, so it catches up with any ticks since the last call.
+     */
+    void Tick() {
+        const uint32_t ticks = OC::CORE::ticks - last_tick;
+        last_tick = OC::CORE::ticks;
+        if (midi_sync && !FollowMidi()) {
+            tock = 0;
+            return;
+        }
+        tock = phase.Advance(ticks);
+        if (tock && ++count >= tocks_per_beat) {
+            count = 0;
+            cycle = 1 - cycle;
         }
-        return tock;
     }
 
+    /* Returns true if the clock fires on this tick, based on the current tempo */
+    bool Tock() {return tock;}
+
     bool EndOfBeat() {return count == 0;}
 
     bool Cycle() {return cycle;}
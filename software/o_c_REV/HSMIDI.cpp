@@ -0,0 +1,6 @@
+#include <Arduino.h>
+#include "OC_core.h"
+#include "HSMIDI.h"
+
+util::WorkQueue<SysExMessage, SYSEX_QUEUE_SIZE> SystemExclusiveHandler::sysex_queue;
+SysExMessage SystemExclusiveHandler::received_sysex;
@@ -30,6 +30,9 @@
 #ifndef HSMIDI_H
 #define HSMIDI_H
 
+#include "OC_midi_input.h"
+#include "util/util_work_queue.h"
+
 // Teensyduino USB MIDI Library message numbers
 // See https://www.pjrc.com/teensy/td_midi.html
 const uint8_t MIDI_MSG_NOTE_ON = 1;
@@ -185,6 +188,16 @@ typedef struct _SysExData {
     }
 } SysExData, UnpackedData, PackedData;
 
+/*
+ * A received SysEx message, as copied from the MIDI library by the ISR
+ */
+typedef struct SysExMessage {
+    uint16_t size;
+    uint8_t data[USB_MIDI_SYSEX_MAX];
+} SysExMessage;
+
+#define SYSEX_QUEUE_SIZE 4
+
 /*
  * Base class for applications that need MIDI SysEx support.
  *
@@ -199,6 +212,13 @@ typedef struct _SysExData {
  * byte. This leaves 55 bytes for application data. However, these
  * are 7-bit MIDI data bytes. Once the bytes are packed, each app
  * may transmit up to 48 bytes, or up to 24 16-bit words.
+ *
+ * Received messages are not handled in the ISR. The ISR only copies them into a
+ * queue, and ProcessSysEx(), which must be called from the app's loop(), hands
+ * them to OnReceiveSysEx() to be unpacked into a pending state. That's put in
+ * with OnApplySysEx(), also in loop(), while the app's ISR is held off, so the
+ * ISR never sees a half-applied message. Since only one app runs at a time, the
+ * queue is shared by all handlers.
  */
 class SystemExclusiveHandler {
 public:
@@ -210,29 +230,70 @@ public:
      */
     virtual void OnSendSysEx();
 
-    /* OnReciveSysEx() is called when a system exclusive message comes in. In OnReceiveSysEx(),
-     * the app is responsible for converting a PackedData instance into an UnpackedData instance,
-     * which contains an array of up to 48 uint8_t bytes, and putting that data into the app's
-     * internal data system.
+    /* OnReciveSysEx() is called from the app's loop() when a system exclusive message comes in. In
+     * OnReceiveSysEx(), the app is responsible for converting a PackedData instance into an
+     * UnpackedData instance, which contains an array of up to 48 uint8_t bytes, and decoding that
+     * data into a pending copy of whatever it changes. The ISR may be running, so the app's live
+     * data should be left alone unless the ISR doesn't use it. Returns true if there's pending data
+     * for OnApplySysEx().
      */
-    virtual void OnReceiveSysEx();
+    virtual bool OnReceiveSysEx();
+
+    /* OnApplySysEx() is called from the app's loop() with the app's ISR held off, right after
+     * OnReceiveSysEx() returned true, to put the pending data into the app's internal data system.
+     * The ISR misses ticks while it runs, so it should be little more than a copy.
+     */
+    virtual void OnApplySysEx() { }
+
+    /* OnOtherMIDI() is called by ListenForSysEx() in the ISR for each other message that the
+     * handler's subscriber passes (by default, all of them).
+     */
+    virtual void OnOtherMIDI(const OC::MidiEvent &event) { }
+
+    /* QueueSysEx() is called in the ISR by apps that read MIDI input themselves, when they read a
+     * system exclusive event in the tick it arrived. The message is dropped if the queue is full.
+     */
+    void QueueSysEx() {
+        SysExMessage message;
+        message.size = usbMIDI.getSysExArrayLength();
+        if (message.size > USB_MIDI_SYSEX_MAX) message.size = USB_MIDI_SYSEX_MAX;
+        memcpy(message.data, usbMIDI.getSysExArray(), message.size);
+        sysex_queue.Push(message);
+    }
+
+    /* ProcessSysEx() is called from the app's loop(), and calls OnReceiveSysEx() for each queued
+     * message, then OnApplySysEx() for each one that left pending data.
+     */
+    int ProcessSysEx() {
+        int processed = 0;
+        while (sysex_queue.Pop(received_sysex)) {
+            if (OnReceiveSysEx()) ApplySysEx();
+            processed++;
+        }
+        return processed;
+    }
 
 protected:
-    /* ListenForSysEx() is for use by apps that don't otherwise deal with listening to MIDI input.
-     * A call to ListenForSysEx() is placed in the ISR. When SysEx is recieved, ListenForSysEx()
-     * calls OnReceiveSysEx().
-     *
-     * IMPORTANT! Do not use ListenForSysEx() in apps that use MIDI in, because ListenForSysEx()
-     * will devour most of the incoming MIDI events, and MIDI in won't work.
+    /* ListenForSysEx() is for use by apps that don't otherwise deal with MIDI input. A call to
+     * ListenForSysEx() is placed in the ISR. It reads the events that arrived since the last call
+     * from midi_events, queues SysEx for ProcessSysEx() and hands anything else to OnOtherMIDI().
+     * While the queue is full, incoming MIDI is left in the USB buffer (see
+     * OC::MidiInput::Stall()), so large dumps are throttled rather than dropped.
      */
     bool ListenForSysEx() {
         bool heard_sysex = 0;
-        if (usbMIDI.read()) {
-            if (usbMIDI.getType() == 7) {
-                OnReceiveSysEx();
-                heard_sysex = 1;
+        OC::MidiEvent event;
+        while (midi_events.Read(event)) {
+            if (event.type == MIDI_MSG_SYSEX) {
+                if (event.tick == OC::CORE::ticks) {
+                    QueueSysEx();
+                    heard_sysex = 1;
+                }
+            } else {
+                OnOtherMIDI(event);
             }
         }
+        if (!sysex_queue.writable()) OC::midi_input.Stall();
         return heard_sysex;
     }
 
@@ -253,8 +314,8 @@ protected:
     }
 
     bool ExtractSysExData(uint8_t *V, char target_id) {
-        // Get the full sysex dump from the MIDI library
-        uint8_t *sysex = usbMIDI.getSysExArray();
+        // Get the full sysex dump, as queued by the ISR
+        const uint8_t *sysex = received_sysex.data;
 
         bool verify = (sysex[1] == 0x7d && sysex[2] == 0x62 && sysex[3] == target_id);
         if (verify) { // Does the received SysEx belong to this app?
@@ -262,7 +323,7 @@ protected:
             PackedData packed;
             uint8_t psize = 0;
             uint8_t data[SYSEX_DATA_MAX_SIZE];
-            for (int i = 0; i < SYSEX_DATA_MAX_SIZE; i++)
+            for (int i = 0; i < SYSEX_DATA_MAX_SIZE && i + 4 < received_sysex.size; i++)
             {
                 uint8_t b = sysex[i + 4]; // Getting packed bytes past the header
                 if (b == 0xf7) break;
@@ -287,8 +348,22 @@ protected:
 
     char LastSysExApplicationCode() {return last_app_code;}
 
+    OC::MidiSubscriber midi_events; // MIDI input for ListenForSysEx(), or for the app itself
+
+    static util::WorkQueue<SysExMessage, SYSEX_QUEUE_SIZE> sysex_queue; // See HSMIDI.cpp
+    static SysExMessage received_sysex; // The message being handled by OnReceiveSysEx()
+
 private:
     char last_app_code; // The most recent application code received
+
+    // The app's ISR is held off, as it is while an app is selected, so that it doesn't run while
+    // OnApplySysEx() is halfway through
+    void ApplySysEx() {
+        bool app_isr_enabled = OC::CORE::app_isr_enabled;
+        OC::CORE::app_isr_enabled = false;
+        OnApplySysEx();
+        OC::CORE::app_isr_enabled = app_isr_enabled;
+    }
 };
 
 /*
@@ -0,0 +1,139 @@
+// Copyright (c) 2018, Jason Justian
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+//////////////////////////////////////////////////////////////////////////
+// Per-applet cycle accounting for Hemisphere
+//
+// With HEMISPHERE_PROFILING defined (see OC_config.h), every Controller()
+// and View() call is timed, and the results are kept for each hemisphere and
+// applet, so that you can find out which applets (and pairs of applets) fit
+// in the ISR budget. The statistics are shown on the APPLETS debug page and
+// can be sent out as a SysEx dump with target 'P'. Each record is one SysEx
+// message with the following unpacked data:
+//
+// [0]      Record type (see HemisphereProfiler::RecordType)
+// [1]      Hemisphere for applet records, or the stage number
+// [2]      Applet id, or 0 for stages
+// [3-6]    Minimum cycles (little-endian)
+// [7-10]   Average cycles
+// [11-14]  Maximum cycles
+// [15-38]  Log2 histogram, 16 bits per bucket (see debug::HistogramCycles)
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef HS_PROFILER_H
+#define HS_PROFILER_H
+
+#ifdef HEMISPHERE_PROFILING
+
+#include "OC_debug.h"
+
+class HemisphereProfiler : public SystemExclusiveHandler {
+public:
+    enum Function {
+        CONTROLLER,
+        VIEW,
+        FUNCTION_LAST
+    };
+
+    enum RecordType {
+        RECORD_STAGE,
+        RECORD_CONTROLLER,
+        RECORD_VIEW
+    };
+
+    void Init(int index, int id) {
+        applet_ids[index] = id;
+    }
+
+    debug::HistogramCycles &stats(int hemisphere, int index, Function fn) {
+        return applet_stats[hemisphere][index][fn];
+    }
+
+    void Reset() {
+        for (int h = 0; h < 2; h++)
+        {
+            for (int i = 0; i < HEMISPHERE_AVAILABLE_APPLETS; i++)
+            {
+                for (int fn = 0; fn < FUNCTION_LAST; fn++) applet_stats[h][i][fn].Reset();
+            }
+        }
+    }
+
+    // Sends the core ISR stages and every applet that has been run
+    void OnSendSysEx() {
+        SendRecord(RECORD_STAGE, 0, 0, OC::DEBUG::DISPLAY_cycles);
+        SendRecord(RECORD_STAGE, 1, 0, OC::DEBUG::DAC_cycles);
+        SendRecord(RECORD_STAGE, 2, 0, OC::DEBUG::ADC_cycles);
+
+        for (int h = 0; h < 2; h++)
+        {
+            for (int i = 0; i < HEMISPHERE_AVAILABLE_APPLETS; i++)
+            {
+                const debug::HistogramCycles &controller = applet_stats[h][i][CONTROLLER];
+                const debug::HistogramCycles &view = applet_stats[h][i][VIEW];
+                if (controller.count()) SendRecord(RECORD_CONTROLLER, h, applet_ids[i], controller);
+                if (view.count()) SendRecord(RECORD_VIEW, h, applet_ids[i], view);
+            }
+        }
+    }
+
+    bool OnReceiveSysEx() { return false; } // Dump only
+
+private:
+    debug::HistogramCycles applet_stats[2][HEMISPHERE_AVAILABLE_APPLETS][FUNCTION_LAST];
+    int applet_ids[HEMISPHERE_AVAILABLE_APPLETS];
+
+    void SendRecord(uint8_t type, uint8_t index, uint8_t id, const debug::HistogramCycles &stats) {
+        uint8_t V[3 + 12 + 2 * debug::HistogramCycles::kBuckets];
+        uint8_t size = 0;
+        V[size++] = type;
+        V[size++] = index;
+        V[size++] = id;
+        size = Pack32(V, size, stats.min_value());
+        size = Pack32(V, size, stats.value());
+        size = Pack32(V, size, stats.max_value());
+        for (int b = 0; b < debug::HistogramCycles::kBuckets; b++)
+        {
+            V[size++] = stats.bucket(b) & 0xff;
+            V[size++] = (stats.bucket(b) >> 8) & 0xff;
+        }
+
+        UnpackedData unpacked;
+        unpacked.set_data(size, V);
+        PackedData packed = unpacked.pack();
+        SendSysEx(packed, 'P');
+    }
+
+    static uint8_t Pack32(uint8_t *V, uint8_t size, uint32_t value) {
+        for (int i = 0; i < 4; i++) V[size++] = (value >> (i * 8)) & 0xff;
+        return size;
+    }
+};
+
+#define HEMISPHERE_PROFILE_SCOPE(hemisphere, index, fn) \
+    OC_DEBUG_PROFILE_SCOPE(profiler.stats(hemisphere, index, HemisphereProfiler::fn))
+
+#else
+
+#define HEMISPHERE_PROFILE_SCOPE(hemisphere, index, fn) do { } while (0)
+
+#endif // HEMISPHERE_PROFILING
+
+#endif // HS_PROFILER_H
@@ -25,8 +25,10 @@
 //// Hemisphere Applet Base Class
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <new>
 #include "HSicons.h"
 #include "HSClockManager.h"
+#include "OC_random.h"
 
 #define LEFT_HEMISPHERE 0
 #define RIGHT_HEMISPHERE 1
@@ -39,9 +41,11 @@
 #endif
 #define HEMISPHERE_3V_CV 4608
 #define HEMISPHERE_CLOCK_TICKS 100
+#define HEMISPHERE_MAX_CLOCK_CYCLE_TICKS (0x7fffffff / OC::DigitalInputs::kCyclesPerTick) // ~17.9s
 #define HEMISPHERE_CURSOR_TICKS 12000
 #define HEMISPHERE_ADC_LAG 33
 #define HEMISPHERE_CHANGE_THRESHOLD 32
+#define HEMISPHERE_BUS_GATE_THRESHOLD (HEMISPHERE_3V_CV / 2) // An output above 1.5V is a high gate on the bus
 
 #ifdef BUCHLA_4U
 #define PULSE_VOLTAGE 8
@@ -72,18 +76,35 @@ typedef struct PackLocation {
     int size;
 } PackLocation;
 
+/* Internal bus between the hemispheres, set up on the Clock Setup screen. Each digital and CV input
+ * of a hemisphere can take one of the other hemisphere's outputs instead of its jack. The outputs are
+ * recorded by Out(), and the Hemisphere Manager runs the hemisphere that feeds the other one first,
+ * so the value or clock arrives in the same tick (see HemisphereManager::ExecuteControllers()).
+ */
+typedef struct HemisphereBus {
+    uint8_t clock_source[2][2]; // [hemisphere][ch]: 0 for the jack, or 1 + the other hemisphere's output channel
+    uint8_t cv_source[2][2];
+    int outputs[2][2]; // Each hemisphere's outputs, as last set by Out()
+    uint16_t edges[2][2]; // Rising edges of each output
+    uint16_t edges_seen[2][2]; // [hemisphere][ch]: The source's edges when this input was last latched
+    bool clocked[2][2]; // [hemisphere][ch]: Latched by the manager before each Controller()
+} HemisphereBus;
+
+// The applets' slots; see Applet Arena below
+static uint8_t hemisphere_applet_arena[2][HEMISPHERE_APPLET_SLOT_SIZE] __attribute__((aligned(8)));
+
 class HemisphereApplet {
 public:
 
     virtual const char* applet_name(); // Maximum of 9 characters
     virtual void Start();
-    virtual void Controller();
     virtual void View();
+    // Each applet also has a Controller(), called every tick. It isn't virtual: the applet's
+    // _Controller() function calls it through AppletSlot::Controller(), which knows the class.
 
     void BaseStart(bool hemisphere_) {
         hemisphere = hemisphere_;
         gfx_offset = hemisphere * 64;
-        io_offset = hemisphere * 2;
 
         // Initialize some things for startup
         ForEachChannel(ch)
@@ -91,10 +112,12 @@ public:
             clock_countdown[ch]  = 0;
             inputs[ch] = 0;
             outputs[ch] = 0;
+            bus.outputs[hemisphere][ch] = 0;
             adc_lag_countdown[ch] = 0;
         }
         help_active = 0;
         cursor_countdown = HEMISPHERE_CURSOR_TICKS;
+        rng[hemisphere].Seed(OC::random_source.ClientSeed(NameHash() ^ hemisphere));
 
         // Shutdown FTM capture on Digital 4, used by Tuner
 #ifdef FLIP_180
@@ -107,35 +130,21 @@ public:
             OC::DigitalInputs::reInit();
         }
 
-        // Maintain previous app state by skipping Start
+        // Start only once per instance. Applets in the arena are constructed anew each time they're
+        // selected, and their previous state is restored by the manager (see AppletSlot).
         if (!applet_started) {
             applet_started = true;
             Start();
         }
     }
 
-    void BaseController(bool master_clock_on) {
-        master_clock_bus = (master_clock_on && hemisphere == RIGHT_HEMISPHERE);
-        ForEachChannel(ch)
-        {
-            // Set CV inputs
-            ADC_CHANNEL channel = (ADC_CHANNEL)(ch + io_offset);
-            inputs[ch] = OC::ADC::raw_pitch_value(channel);
-            if (abs(inputs[ch] - last_cv[ch]) > HEMISPHERE_CHANGE_THRESHOLD) {
-                changed_cv[ch] = 1;
-                last_cv[ch] = inputs[ch];
-            } else changed_cv[ch] = 0;
-
-            // Handle clock timing
-            if (clock_countdown[ch] > 0) {
-                if (--clock_countdown[ch] == 0) Out(ch, 0);
-            }
-        }
-
-        // Cursor countdowns. See CursorBlink(), ResetCursor(), gfxCursor()
-        if (--cursor_countdown < -HEMISPHERE_CURSOR_TICKS) cursor_countdown = HEMISPHERE_CURSOR_TICKS;
-
-        Controller();
+    /* A tick for the applet, of class AppletClass. Controller() is called directly, and is inlined
+     * into the caller (see AppletSlot::Controller()).
+     */
+    template <class AppletClass>
+    __attribute__((always_inline)) void BaseController(bool master_clock_on) {
+        BeginTick(master_clock_on);
+        static_cast<AppletClass *>(this)->AppletClass::Controller();
     }
 
     void BaseView() {
@@ -306,15 +315,37 @@ public:
         return inputs[ch];
     }
 
+    /* The input's samples since the last tick, oldest first, in the same units as In().
+     * Returns how many were copied, up to max_n. With ADC_DMA_SCAN there are several per
+     * tick; otherwise each input gets a new sample every fourth tick. */
+    int InBlock(int ch, int32_t *dst, int max_n) {
+        if (bus.cv_source[Side()][ch]) { // One sample per tick from the bus
+            if (max_n < 1) return 0;
+            dst[0] = In(ch);
+            return 1;
+        }
+        ADC_CHANNEL channel = (ADC_CHANNEL)(ch + io_offset());
+        int n = OC::ADC::scan_samples(channel);
+        if (n > max_n) n = max_n;
+        OC::ADC::pitch_block(channel, dst, n);
+        return n;
+    }
+
     // Apply small center detent to input, so it reads zero before a threshold
     int DetentedIn(int ch) {
         return (In(ch) > (HEMISPHERE_CENTER_CV + 64) || In(ch) < (HEMISPHERE_CENTER_CV - 64)) ? In(ch) : HEMISPHERE_CENTER_CV;
     }
 
     void Out(int ch, int value, int octave = 0) {
-        DAC_CHANNEL channel = (DAC_CHANNEL)(ch + io_offset);
+        DAC_CHANNEL channel = (DAC_CHANNEL)(ch + io_offset());
         OC::DAC::set_pitch(channel, value, octave);
         outputs[ch] = value + (octave * (12 << 7));
+
+        int &bus_output = bus.outputs[Side()][ch];
+        if (outputs[ch] > HEMISPHERE_BUS_GATE_THRESHOLD && bus_output <= HEMISPHERE_BUS_GATE_THRESHOLD) {
+            ++bus.edges[Side()][ch];
+        }
+        bus_output = outputs[ch];
     }
 
     /*
@@ -325,23 +356,15 @@ public:
      */
     bool Clock(int ch, bool physical = 0) {
         bool clocked = 0;
-        if (hemisphere == 0) {
-            if (ch == 0) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_1>();
-            if (ch == 1) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_2>();
-        } else if (hemisphere == 1) {
-            if (ch == 0) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_3>();
-            if (ch == 1) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_4>();
-        }
-
-        if (ch == 0 && !physical) {
-            ClockManager *clock_m = clock_m->get();
-            if (clock_m->IsRunning()) clocked = clock_m->Tock();
-            else if (master_clock_bus) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_1>();
-        }
-
-        if (clocked) {
-        		cycle_ticks[ch] = OC::CORE::ticks - last_clock[ch];
-        		last_clock[ch] = OC::CORE::ticks;
+        OC::DigitalInput input = ClockInput(ch, physical);
+        if (bus.clock_source[Side()][ch]) clocked = bus.clocked[Side()][ch];
+        else if (input == OC::DIGITAL_INPUT_LAST) clocked = ClockManager::get()->Tock();
+        else clocked = OC::DigitalInputs::clocked(input);
+
+        // Applets may ask more than once per tick
+        if (clocked && last_clock[ch] != OC::CORE::ticks) {
+            cycle_ticks[ch] = OC::CORE::ticks - last_clock[ch];
+            last_clock[ch] = OC::CORE::ticks;
         }
         return clocked;
     }
@@ -352,12 +375,15 @@ public:
     }
 
     bool Gate(int ch) {
+        int source = bus.clock_source[Side()][ch];
+        if (source) return bus.outputs[1 - Side()][source - 1] > HEMISPHERE_BUS_GATE_THRESHOLD;
+
         bool high = 0;
-        if (hemisphere == 0) {
+        if (Side() == 0) {
             if (ch == 0) high = OC::DigitalInputs::read_immediate<OC::DIGITAL_INPUT_1>();
             if (ch == 1) high = OC::DigitalInputs::read_immediate<OC::DIGITAL_INPUT_2>();
         }
-        if (hemisphere == 1) {
+        if (Side() == 1) {
             if (ch == 0) high = OC::DigitalInputs::read_immediate<OC::DIGITAL_INPUT_3>();
             if (ch == 1) high = OC::DigitalInputs::read_immediate<OC::DIGITAL_INPUT_4>();
         }
@@ -374,6 +400,36 @@ public:
     int ClockCycleTicks(int ch) {return cycle_ticks[ch];}
     bool Changed(int ch) {return changed_cv[ch];}
 
+    /* Clock timing to the CPU cycle (ARM_DWT_CYCCNT), from the pin interrupt's timestamps of
+     * the clock edges rather than the tick that saw them. Use in the tick when Clock(ch) was true:
+     *
+     * ClockCycles(ch): when the clock came
+     * ClockCycleCycles(ch): cycles since the previous clock
+     * ClockEdges(ch): number of edges that Clock(ch) stood for, when triggers are faster than ticks
+     * TickCycles(): when this tick's inputs were scanned, to compare with the above
+     *
+     * Clocks from the ClockManager or the bus fall back to tick timing. Periods saturate at 0x7fffffff
+     * (~17.9s), so e.g. (int32_t)(TickCycles() - ClockCycles(ch)) comparisons are safe.
+     */
+    uint32_t ClockCycles(int ch) {
+        OC::DigitalInput input = ClockInput(ch);
+        return input == OC::DIGITAL_INPUT_LAST ? TickCycles() : OC::DigitalInputs::edge_cycles(input);
+    }
+
+    uint32_t ClockCycleCycles(int ch) {
+        OC::DigitalInput input = ClockInput(ch);
+        if (cycle_ticks[ch] > HEMISPHERE_MAX_CLOCK_CYCLE_TICKS) return 0x7fffffff;
+        if (input == OC::DIGITAL_INPUT_LAST) return cycle_ticks[ch] * OC::DigitalInputs::kCyclesPerTick;
+        return OC::DigitalInputs::period_cycles(input);
+    }
+
+    int ClockEdges(int ch) {
+        OC::DigitalInput input = ClockInput(ch);
+        return input == OC::DIGITAL_INPUT_LAST ? 1 : OC::DigitalInputs::edges(input);
+    }
+
+    uint32_t TickCycles() {return OC::DigitalInputs::scan_cycles();}
+
 protected:
     bool hemisphere; // Which hemisphere (0, 1) this applet uses
     const char* help[4];
@@ -443,7 +499,8 @@ protected:
      * }
      */
     void StartADCLag(int ch = 0) {
-        adc_lag_countdown[ch] = HEMISPHERE_ADC_LAG;
+        // CV from the bus is already current, so the lag ends with the first EndOfADCLag()
+        adc_lag_countdown[ch] = bus.cv_source[Side()][ch] ? 1 : HEMISPHERE_ADC_LAG;
     }
 
     bool EndOfADCLag(int ch = 0) {
@@ -453,9 +510,85 @@ protected:
     /* Master Clock Forwarding is activated. This is updated with each ISR cycle by the Hemisphere Manager */
     bool MasterClockForwarded() {return master_clock_bus;}
 
+    /* Multi-rate scheduling: An applet declared with DECLARE_DECIMATED_APPLET still has its Controller()
+     * called every tick, so that clocks, gates and trigger outputs are handled as usual, but it should
+     * only do its control-rate work when ControlTick() is true, once every ControlDecimation() ticks.
+     * The Hemisphere Manager staggers the slots, so the two hemispheres never do this work on the same
+     * tick. For applets declared with DECLARE_APPLET, ControlTick() is always true.
+     *
+     * if (ControlTick()) {
+     *     // Heavy lifting
+     * }
+     */
+    bool ControlTick() {return control_tick[Side()];}
+    int ControlDecimation() {return control_decimation[Side()];}
+
+    /* Random numbers from the hemisphere's own generator, in [min, max) like Arduino random(min, max)
+     * but without the division. The generator is seeded whenever the applet is selected; with a fixed
+     * seed (see OC_random.h), an applet gets the same sequence each time in the same hemisphere.
+     */
+    int Random(int min, int max) {return rng[Side()].Range(min, max);}
+    util::Random &RandomGenerator() {return rng[Side()];}
+
+public:
+    static bool control_tick[2]; // Updated with each ISR cycle by the Hemisphere Manager
+    static uint8_t control_decimation[2];
+    static HemisphereBus bus;
+
 private:
+    static util::Random rng[2];
+
+    // Inputs and countdowns for each tick, before the applet's Controller()
+    __attribute__((always_inline)) void BeginTick(bool master_clock_on) {
+        master_clock_bus = (master_clock_on && Side() == RIGHT_HEMISPHERE);
+        ForEachChannel(ch)
+        {
+            // Set CV inputs, from the jack or the bus
+            int source = bus.cv_source[Side()][ch];
+            if (source) inputs[ch] = bus.outputs[1 - Side()][source - 1];
+            else inputs[ch] = OC::ADC::raw_pitch_value((ADC_CHANNEL)(ch + io_offset()));
+            if (abs(inputs[ch] - last_cv[ch]) > HEMISPHERE_CHANGE_THRESHOLD) {
+                changed_cv[ch] = 1;
+                last_cv[ch] = inputs[ch];
+            } else changed_cv[ch] = 0;
+
+            // Handle clock timing
+            if (clock_countdown[ch] > 0) {
+                if (--clock_countdown[ch] == 0) Out(ch, 0);
+            }
+        }
+
+        // Cursor countdowns. See CursorBlink(), ResetCursor(), gfxCursor()
+        if (--cursor_countdown < -HEMISPHERE_CURSOR_TICKS) cursor_countdown = HEMISPHERE_CURSOR_TICKS;
+    }
+
+    uint32_t NameHash() { // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (const char *c = applet_name(); *c; c++) hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+        return hash;
+    }
+
+    // The digital input that clocks channel ch, or DIGITAL_INPUT_LAST for the ClockManager or the bus
+    OC::DigitalInput ClockInput(int ch, bool physical = 0) {
+        if (bus.clock_source[Side()][ch]) return OC::DIGITAL_INPUT_LAST;
+        if (ch == 0 && !physical) {
+            ClockManager *clock_m = clock_m->get();
+            if (clock_m->IsRunning()) return OC::DIGITAL_INPUT_LAST;
+            if (master_clock_bus) return OC::DIGITAL_INPUT_1;
+        }
+        return (OC::DigitalInput)(ch + io_offset());
+    }
+
+    /* The hemisphere of the arena slot that the applet is in, which is always the same as hemisphere.
+     * Applets outside the arena (Clock Setup) are on the left.
+     */
+    bool Side() const {
+        return reinterpret_cast<const uint8_t *>(this) == hemisphere_applet_arena[RIGHT_HEMISPHERE];
+    }
+
+    int io_offset() const {return Side() * 2;} // Input/Output offset, based on the side
+
     int gfx_offset; // Graphics offset, based on the side
-    int io_offset; // Input/Output offset, based on the side
     int inputs[2];
     int outputs[2];
     uint32_t last_clock[2]; // Tick number of the last clock observed by the child class
@@ -470,3 +603,45 @@ private:
     bool changed_cv[2]; // Has the input changed by more than 1/8 semitone since the last read?
     int last_cv[2]; // For change detection
 };
+
+bool HemisphereApplet::control_tick[2];
+uint8_t HemisphereApplet::control_decimation[2];
+HemisphereBus HemisphereApplet::bus;
+util::Random HemisphereApplet::rng[2];
+
+////////////////////////////////////////////////////////////////////////////////
+//// Applet Arena
+////////////////////////////////////////////////////////////////////////////////
+
+/* Only the two selected applets exist at any time. Each hemisphere has a slot of
+ * HEMISPHERE_APPLET_SLOT_SIZE bytes (see hemisphere_config.h) in the arena, and an applet's
+ * Start function constructs it into that slot. Applet_instance[hemisphere] is then the applet
+ * in the slot.
+ *
+ * When an applet is replaced, HemisphereManager keeps its OnDataRequest() data as a snapshot,
+ * and hands it back with OnDataReceive() the next time the applet is selected. So the previous
+ * settings are maintained, but runtime state (sequence positions, recordings, etc.) is not.
+ */
+template <class AppletClass>
+class AppletSlot {
+public:
+    static_assert(sizeof(AppletClass) <= HEMISPHERE_APPLET_SLOT_SIZE,
+                  "Applet doesn't fit in the arena; increase HEMISPHERE_APPLET_SLOT_SIZE");
+
+    AppletClass &operator[](int hemisphere) {
+        return *reinterpret_cast<AppletClass *>(hemisphere_applet_arena[hemisphere]);
+    }
+
+    /* Construct a new instance in the hemisphere's slot, replacing whatever was there */
+    AppletClass &Construct(int hemisphere) {
+        return *new (hemisphere_applet_arena[hemisphere]) AppletClass();
+    }
+
+    /* Run the applet in the hemisphere's slot for a tick. Its Controller() is called directly rather
+     * than through the vtable, and the one copy serves both slots.
+     */
+    void Controller(bool hemisphere, bool forwarding) {
+        (*this)[hemisphere].template BaseController<AppletClass>(forwarding);
+    }
+};
+
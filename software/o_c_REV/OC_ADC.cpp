@@ -1,5 +1,8 @@
 #include "OC_ADC.h"
 #include "OC_gpio.h"
+#ifdef ADC_DMA_SCAN
+#include "src/drivers/ADC/ScanDMA.h"
+#endif
 
 #include <algorithm>
 
@@ -24,6 +27,15 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
 /*static*/ ADC::CalibrationData *ADC::calibration_data_;
 /*static*/ uint32_t ADC::raw_[ADC_CHANNEL_LAST];
 /*static*/ uint32_t ADC::smoothed_[ADC_CHANNEL_LAST];
+#ifdef ADC_DMA_SCAN
+// Aligned for the DMA destination address modulo
+/*static*/ volatile uint16_t ADC::scan_ring_[kScanRingLength * ADC_CHANNEL_LAST] __attribute__((aligned(ADC::kScanRingLength * ADC_CHANNEL_LAST * sizeof(uint16_t))));
+#else
+/*static*/ volatile uint16_t ADC::scan_ring_[kScanRingLength * ADC_CHANNEL_LAST];
+#endif
+/*static*/ uint32_t ADC::scan_count_;
+/*static*/ uint32_t ADC::last_scan_count_;
+/*static*/ uint32_t ADC::scan_delta_;
 #ifdef ENABLE_ADC_DEBUG
 /*static*/ volatile uint32_t ADC::busy_waits_;
 #endif
@@ -41,17 +53,31 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   adc_.setResolution(kAdcScanResolution);
   adc_.setConversionSpeed(kAdcConversionSpeed);
   adc_.setSamplingSpeed(kAdcSamplingSpeed);
+#ifdef ADC_DMA_SCAN
+  adc_.setAveraging(kAdcDmaScanAverages);
+#else
   adc_.setAveraging(kAdcScanAverages);
+#endif
   adc_.disableDMA();
   adc_.disableInterrupts();
   adc_.disableCompare();
 
-  scan_channel_ = ADC_CHANNEL_1;
-  adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_1>::PIN);
-
   calibration_data_ = calibration_data;
   std::fill(raw_, raw_ + ADC_CHANNEL_LAST, 0);
   std::fill(smoothed_, smoothed_ + ADC_CHANNEL_LAST, 0);
+  std::fill(scan_ring_, scan_ring_ + kScanRingLength * ADC_CHANNEL_LAST, 0);
+  scan_count_ = last_scan_count_ = scan_delta_ = 0;
+
+  scan_channel_ = ADC_CHANNEL_1;
+#ifdef ADC_DMA_SCAN
+  static const uint8_t pins[ADC_CHANNEL_LAST] = {
+    ChannelDesc<ADC_CHANNEL_1>::PIN, ChannelDesc<ADC_CHANNEL_2>::PIN,
+    ChannelDesc<ADC_CHANNEL_3>::PIN, ChannelDesc<ADC_CHANNEL_4>::PIN
+  };
+  ScanDMA::Start(adc_, pins, ADC_CHANNEL_LAST, scan_ring_, kScanRingLength * ADC_CHANNEL_LAST);
+#else
+  adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_1>::PIN);
+#endif
 #ifdef ENABLE_ADC_DEBUG
   busy_waits_ = 0;
 #endif
@@ -61,6 +87,24 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
 // use ADC::startSynchronizedSingleRead, which would allow reading two channels
 // simultaneously
 
+#ifdef ADC_DMA_SCAN
+
+/*static*/ void FASTRUN ADC::Scan() {
+  // The ring holds ~2ms of samples, so it can't have wrapped since the
+  // last call
+  const uint32_t delta = (ScanDMA::write_index() - scan_count_) & kScanRingMask;
+  last_scan_count_ = scan_count_;
+  scan_count_ += delta;
+  scan_delta_ = delta;
+
+  update<ADC_CHANNEL_1>(scan_ring_[newest(ADC_CHANNEL_1)]);
+  update<ADC_CHANNEL_2>(scan_ring_[newest(ADC_CHANNEL_2)]);
+  update<ADC_CHANNEL_3>(scan_ring_[newest(ADC_CHANNEL_3)]);
+  update<ADC_CHANNEL_4>(scan_ring_[newest(ADC_CHANNEL_4)]);
+}
+
+#else
+
 /*static*/ void FASTRUN ADC::Scan() {
 
 #ifdef ENABLE_ADC_DEBUG
@@ -70,6 +114,9 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   }
 #endif
   const uint16_t value = adc_.readSingle(ADC_0);
+  scan_ring_[scan_count_ & kScanRingMask] = value;
+  last_scan_count_ = scan_count_++;
+  scan_delta_ = 1;
 
   size_t channel = scan_channel_;
   switch (channel) {
@@ -100,6 +147,20 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   scan_channel_ = channel;
 }
 
+#endif // ADC_DMA_SCAN
+
+/*static*/ void ADC::pitch_block(ADC_CHANNEL channel, int32_t *dst, size_t n) {
+  const int32_t offset = calibration_data_->offset[channel];
+  const int32_t scale = calibration_data_->pitch_cv_scale;
+  uint32_t index = newest(channel);
+  dst += n;
+  while (n--) {
+    const int32_t value = offset - (scan_ring_[index] >> (kAdcScanResolution - kAdcResolution));
+    *--dst = (value * scale) >> 12;
+    index = (index - ADC_CHANNEL_LAST) & kScanRingMask;
+  }
+}
+
 /*static*/ void ADC::CalibratePitch(int32_t c2, int32_t c4) {
   // This is the method used by the Mutable Instruments calibration and
   // extrapolates from two octaves. I guess an alternative would be to get the
@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "src/drivers/ADC/OC_util_ADC.h"
 #include "OC_config.h"
+#include "OC_options.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -37,6 +38,16 @@ public:
 
   static constexpr uint32_t kAdcValueShift = kAdcSmoothBits;
 
+  // Each channel's most recent samples are kept in an interleaved ring. With
+  // ADC_DMA_SCAN the ring is filled by DMA as fast as the ADC converts, using
+  // fewer hardware averages so it converts faster; otherwise Scan() adds one
+  // sample of one channel per ISR.
+  static constexpr size_t kScanRingLength = 64; // samples per channel, power of two
+  static constexpr uint32_t kScanRingMask = kScanRingLength * ADC_CHANNEL_LAST - 1;
+#ifdef ADC_DMA_SCAN
+  static constexpr uint8_t kAdcDmaScanAverages = 4;
+#endif
+
 
   struct CalibrationData {
     uint16_t offset[ADC_CHANNEL_LAST];
@@ -48,9 +59,9 @@ public:
 
   // Read the value of the last conversion and update current channel, then
   // start the next conversion. If necessary, some channels could be given
-  // priority by scanning them more often. Even better might be some kind of
-  // continuous/DMA sampling to make things even more independent of the main
-  // ISR timing restrictions.
+  // priority by scanning them more often. With ADC_DMA_SCAN the conversions
+  // run independently of the ISR, and this only picks up the latest sample of
+  // each channel from the ring.
   static void Scan();
 
   template <ADC_CHANNEL channel>
@@ -79,6 +90,17 @@ public:
     return (value * calibration_data_->pitch_cv_scale) >> 12;
   }
 
+  // Number of samples of the channel that arrived up to the last Scan(), since
+  // the one before it
+  static size_t scan_samples(ADC_CHANNEL channel) {
+    const size_t first = (channel - last_scan_count_) & (ADC_CHANNEL_LAST - 1);
+    return scan_delta_ > first ? (scan_delta_ - first + ADC_CHANNEL_LAST - 1) / ADC_CHANNEL_LAST : 0;
+  }
+
+  // The last n (up to kScanRingLength) samples of the channel as of the last
+  // Scan(), oldest first, scaled like raw_pitch_value.
+  static void pitch_block(ADC_CHANNEL channel, int32_t *dst, size_t n);
+
 #ifdef ENABLE_ADC_DEBUG
   // DEBUG
   static uint16_t fail_flag0() {
@@ -114,6 +136,16 @@ private:
   static uint32_t raw_[ADC_CHANNEL_LAST];
   static uint32_t smoothed_[ADC_CHANNEL_LAST];
 
+  static volatile uint16_t scan_ring_[kScanRingLength * ADC_CHANNEL_LAST];
+  static uint32_t scan_count_; // Samples written to the ring up to the last Scan()
+  static uint32_t last_scan_count_;
+  static uint32_t scan_delta_;
+
+  // Ring index of the newest sample of channel as of the last Scan()
+  static uint32_t newest(size_t channel) {
+    return (scan_count_ - 1 - ((scan_count_ - 1 - channel) & (ADC_CHANNEL_LAST - 1))) & kScanRingMask;
+  }
+
 #ifdef ENABLE_ADC_DEBUG
   static volatile uint32_t busy_waits_;
 #endif
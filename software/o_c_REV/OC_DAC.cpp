@@ -49,6 +49,7 @@ namespace OC {
 void DAC::Init(CalibrationData *calibration_data) {
 
   calibration_data_ = calibration_data;
+  calibration_data_changed();
   
   restore_scaling(0x0);
 
@@ -68,6 +69,8 @@ void DAC::Init(CalibrationData *calibration_data) {
   if (F_BUS == 60000000 || F_BUS == 48000000) 
     SPIFIFO.begin(DAC_CS, SPICLOCK_30MHz, SPI_MODE0);  
 
+  for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i)
+    sent_values_[i] = kInvalidValue;
   set_all(0xffff);
   Update();
 }
@@ -92,6 +95,7 @@ void DAC::set_auto_channel_calibration_data(uint8_t channel_id) {
         const OC::Autotune_data &autotune_data = OC::AUTOTUNE::GetAutotune_data(channel_id);
         for (int i = 0; i < OCTAVES + 1; i++)
           calibration_data_->calibrated_octaves[channel_id][i] = autotune_data.auto_calibrated_octaves[i];
+        calibration_data_changed();
     } 
   }
 }
@@ -105,6 +109,7 @@ void DAC::set_default_channel_calibration_data(uint8_t channel_id) {
     // reset data
     for (int i = 0; i < OCTAVES + 1; i++) 
       calibration_data_->calibrated_octaves[channel_id][i] = OC::calibration_data.dac.calibrated_octaves[channel_id][i];
+    calibration_data_changed();
     // + update info
     OC::Autotune_data *autotune_data = &OC::auto_calibration_data[channel_id];
     if (autotune_data->use_auto_calibration_ == 0xFF || autotune_data->use_auto_calibration_ == 0x01)
@@ -167,14 +172,47 @@ void DAC::choose_calibration_data() {
   }
 }
 /*static*/
+void DAC::calibration_data_changed() {
+  // Slopes for pitch_to_dac, see kSlopeShift. (span << kSlopeShift) / (12 << 7) is
+  // (span << 13) / 3.
+  for (int channel = 0; channel < DAC_CHANNEL_LAST; ++channel) {
+    const uint16_t *octaves = calibration_data_->calibrated_octaves[channel];
+    for (int octave = 0; octave < OCTAVES; ++octave) {
+      const int32_t span = octaves[octave + 1] - octaves[octave];
+      const int64_t magnitude = ((static_cast<int64_t>(span < 0 ? -span : span) << 13) + 2) / 3;
+      octave_slopes_[channel][octave] = span < 0 ? -magnitude : magnitude;
+    }
+    octave_slopes_[channel][OCTAVES] = 0; // Top of the range, fractional is always 0
+  }
+}
+/*static*/
 uint8_t DAC::get_voltage_scaling(uint8_t channel_id) {
   return DAC_scaling[channel_id];
 }
 /*static*/
 void DAC::set_scaling(uint8_t scaling, uint8_t channel_id) {
 
-  if (channel_id < DAC_CHANNEL_LAST)
+  if (channel_id < DAC_CHANNEL_LAST) {
     DAC_scaling[channel_id] = scaling;
+
+    // Multiplier and shift for scaled_pitch_to_dac, as in pitch_to_scaled_voltage_dac
+    int32_t multiplier = 1;
+    uint8_t shift = 0;
+    switch (scaling) {
+      case VOLTAGE_SCALING_CARLOS_ALPHA:  multiplier = 25548; shift = 15; break;
+      case VOLTAGE_SCALING_CARLOS_BETA:   multiplier = 20917; shift = 15; break;
+      case VOLTAGE_SCALING_CARLOS_GAMMA:  multiplier = 11501; shift = 15; break;
+      case VOLTAGE_SCALING_BOHLEN_PIERCE: multiplier = 25969; shift = 14; break;
+      case VOLTAGE_SCALING_QUARTERTONE:   multiplier = 1; shift = 1; break;
+      #ifdef BUCHLA_SUPPORT
+      case VOLTAGE_SCALING_1_2V_PER_OCT:  multiplier = 19661; shift = 14; break;
+      case VOLTAGE_SCALING_2V_PER_OCT:    multiplier = 2; shift = 0; break;
+      #endif
+      default: break; // VOLTAGE_SCALING_1V_PER_OCT
+    }
+    scaling_multipliers_[channel_id] = multiplier;
+    scaling_shifts_[channel_id] = shift;
+  }
 }
 /*static*/
 void DAC::restore_scaling(uint32_t scaling) {
@@ -196,8 +234,16 @@ uint32_t DAC::store_scaling() {
 /*static*/
 DAC::CalibrationData *DAC::calibration_data_ = nullptr;
 /*static*/
+int32_t DAC::octave_slopes_[DAC_CHANNEL_LAST][OCTAVES + 1];
+/*static*/
+int32_t DAC::scaling_multipliers_[DAC_CHANNEL_LAST];
+/*static*/
+uint8_t DAC::scaling_shifts_[DAC_CHANNEL_LAST];
+/*static*/
 uint32_t DAC::values_[DAC_CHANNEL_LAST];
 /*static*/
+uint32_t DAC::sent_values_[DAC_CHANNEL_LAST];
+/*static*/
 uint16_t DAC::history_[DAC_CHANNEL_LAST][DAC::kHistoryDepth];
 /*static*/ 
 volatile size_t DAC::history_tail_;
@@ -38,6 +38,7 @@ class DAC {
 public:
   static constexpr size_t kHistoryDepth = 8;
   static constexpr uint16_t MAX_VALUE = 65535; // DAC fullscale 
+  static constexpr uint32_t kInvalidValue = 0xffffffff; // Never a USAT16 value
 
   #ifdef BUCHLA_4U
     static constexpr int kOctaveZero = 0;
@@ -58,6 +59,7 @@ public:
   static void reset_auto_channel_calibration_data(uint8_t channel_id);
   static void reset_all_auto_channel_calibration_data();
   static void choose_calibration_data();
+  static void calibration_data_changed();
   static void set_scaling(uint8_t scaling, uint8_t channel_id);
   static void restore_scaling(uint32_t scaling);
   static uint8_t get_voltage_scaling(uint8_t channel_id);
@@ -96,19 +98,7 @@ public:
   // @return DAC output value
   static int32_t pitch_to_dac(DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset) {
     pitch += (kOctaveZero + octave_offset) * 12 << 7;
-    
-    CONSTRAIN(pitch, 0, (120 << 7));
-
-    const int32_t octave = pitch / (12 << 7);
-    const int32_t fractional = pitch - octave * (12 << 7);
-
-    int32_t sample = calibration_data_->calibrated_octaves[channel][octave];
-    if (fractional) {
-      int32_t span = calibration_data_->calibrated_octaves[channel][octave + 1] - sample;
-      sample += (fractional * span) / (12 << 7);
-    }
-
-    return sample;
+    return interpolate_octaves(channel, pitch);
   }
 
   // Specialised versions with voltage scaling
@@ -117,7 +107,12 @@ public:
     return pitch_to_scaled_voltage_dac(channel, semi << 7, octave_offset, voltage_scaling);
   }
   
+  // voltage_scaling is normally the channel's own setting, which is resolved
+  // once in set_scaling, see scaled_pitch_to_dac.
   static int32_t pitch_to_scaled_voltage_dac(DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset, uint8_t voltage_scaling) {
+    if (voltage_scaling == DAC_scaling[channel])
+      return scaled_pitch_to_dac(channel, pitch, octave_offset);
+
     pitch += (octave_offset * 12) << 7;
 
  
@@ -153,19 +148,15 @@ public:
     }
 
     pitch += (kOctaveZero * 12) << 7;
-   
-    CONSTRAIN(pitch, 0, (120 << 7));
-
-    const int32_t octave = pitch / (12 << 7);
-    const int32_t fractional = pitch - octave * (12 << 7);
-
-    int32_t sample = calibration_data_->calibrated_octaves[channel][octave];
-    if (fractional) {
-      int32_t span = calibration_data_->calibrated_octaves[channel][octave + 1] - sample;
-      sample += (fractional * span) / (12 << 7);
-    }
+    return interpolate_octaves(channel, pitch);
+  }
 
-    return sample;
+  // pitch_to_scaled_voltage_dac with the channel's voltage scaling
+  static int32_t scaled_pitch_to_dac(DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset) {
+    pitch += (octave_offset * 12) << 7;
+    pitch = (pitch * scaling_multipliers_[channel]) >> scaling_shifts_[channel];
+    pitch += (kOctaveZero * 12) << 7;
+    return interpolate_octaves(channel, pitch);
   }
     
   // Set channel to semitone value
@@ -206,12 +197,26 @@ public:
     return calibration_data_->calibrated_octaves[channel][kOctaveZero + octave];
   }
 
+  // Only channels that changed since the last Update are sent. The DAC holds
+  // the others, and the SPI bus time goes to the display page transfer.
   static void Update() {
 
-    set8565_CHA(values_[DAC_CHANNEL_A]);
-    set8565_CHB(values_[DAC_CHANNEL_B]);
-    set8565_CHC(values_[DAC_CHANNEL_C]);
-    set8565_CHD(values_[DAC_CHANNEL_D]);
+    if (values_[DAC_CHANNEL_A] != sent_values_[DAC_CHANNEL_A]) {
+      set8565_CHA(values_[DAC_CHANNEL_A]);
+      sent_values_[DAC_CHANNEL_A] = values_[DAC_CHANNEL_A];
+    }
+    if (values_[DAC_CHANNEL_B] != sent_values_[DAC_CHANNEL_B]) {
+      set8565_CHB(values_[DAC_CHANNEL_B]);
+      sent_values_[DAC_CHANNEL_B] = values_[DAC_CHANNEL_B];
+    }
+    if (values_[DAC_CHANNEL_C] != sent_values_[DAC_CHANNEL_C]) {
+      set8565_CHC(values_[DAC_CHANNEL_C]);
+      sent_values_[DAC_CHANNEL_C] = values_[DAC_CHANNEL_C];
+    }
+    if (values_[DAC_CHANNEL_D] != sent_values_[DAC_CHANNEL_D]) {
+      set8565_CHD(values_[DAC_CHANNEL_D]);
+      sent_values_[DAC_CHANNEL_D] = values_[DAC_CHANNEL_D];
+    }
 
     size_t tail = history_tail_;
     history_[DAC_CHANNEL_A][tail] = values_[DAC_CHANNEL_A];
@@ -237,8 +242,35 @@ public:
   }
 
 private:
+  // Octave slopes are (span / (12 << 7)) << kSlopeShift, rounded up in magnitude and
+  // signed like the span. 22 bits is the least for which (fractional * slope) >>
+  // kSlopeShift is always the same as (fractional * span) / (12 << 7).
+  static constexpr int kSlopeShift = 22;
+
+  // Linear interpolation between the calibrated octaves, without divisions or
+  // branches. pitch is 0 (lowest calibrated octave) to 120 << 7.
+  static int32_t interpolate_octaves(DAC_CHANNEL channel, int32_t pitch) {
+    CONSTRAIN(pitch, 0, (120 << 7));
+
+    // pitch / (12 << 7) is (pitch >> 9) / 3, and (x * 11) >> 5 == x / 3 for x <= 30
+    const int32_t octave = ((pitch >> 9) * 11) >> 5;
+    const uint32_t fractional = pitch - octave * (12 << 7);
+
+    // Truncate toward zero for negative spans, like the division
+    const int32_t slope = octave_slopes_[channel][octave];
+    const int32_t sign = slope >> 31;
+    const uint32_t magnitude = (slope ^ sign) - sign;
+    const int32_t delta = static_cast<int32_t>((static_cast<uint64_t>(fractional) * magnitude) >> kSlopeShift);
+
+    return calibration_data_->calibrated_octaves[channel][octave] + ((delta ^ sign) - sign);
+  }
+
   static CalibrationData *calibration_data_;
+  static int32_t octave_slopes_[DAC_CHANNEL_LAST][OCTAVES + 1];
+  static int32_t scaling_multipliers_[DAC_CHANNEL_LAST];
+  static uint8_t scaling_shifts_[DAC_CHANNEL_LAST];
   static uint32_t values_[DAC_CHANNEL_LAST];
+  static uint32_t sent_values_[DAC_CHANNEL_LAST]; // Last value sent to the DAC, kInvalidValue to force a send
   static uint16_t history_[DAC_CHANNEL_LAST][kHistoryDepth];
   static volatile size_t history_tail_;
   static uint8_t DAC_scaling[DAC_CHANNEL_LAST];
@@ -64,6 +64,10 @@ struct App {
   void (*HandleEncoderEvent)(const UI::Event &);
 
   void (*isr)();
+
+  // Optional: restore storage of a different size, saved by an older version of the app, instead of
+  // skipping it. Gets the length of the storage.
+  size_t (*Migrate)(const void *, size_t);
 };
 
 namespace apps {
@@ -81,6 +85,15 @@ namespace apps {
   App *find(uint16_t id);
   int index_of(uint16_t id);
 
+  // Saving the settings only takes a snapshot; the EEPROM is then written a
+  // few bytes at a time by SaveStep, once per main loop pass, so the UI isn't
+  // stalled while it's busy. Progress is in percent.
+  void Save();
+  bool SaveStep();
+  bool save_pending();
+  uint32_t save_progress();
+  void DrawSaveProgress();
+
 }; // namespace apps
 
 }; // namespace OC
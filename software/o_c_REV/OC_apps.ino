@@ -22,20 +22,26 @@
 
 #include "OC_apps.h"
 #include "OC_digital_inputs.h"
+#include "OC_frame_pacing.h"
+#include "OC_midi_input.h"
 #include "OC_autotune.h"
 
-#define DECLARE_APP(a, b, name, prefix) \
-{ TWOCC<a,b>::value, name, \
+#define APP_FUNCTIONS(a, b, name, prefix) \
+  TWOCC<a,b>::value, name, \
   prefix ## _init, prefix ## _storageSize, prefix ## _save, prefix ## _restore, \
   prefix ## _handleAppEvent, \
   prefix ## _loop, prefix ## _menu, prefix ## _screensaver, \
   prefix ## _handleButtonEvent, \
   prefix ## _handleEncoderEvent, \
-  prefix ## _isr \
-}
+  prefix ## _isr
+
+#define DECLARE_APP(a, b, name, prefix) { APP_FUNCTIONS(a, b, name, prefix) }
+
+// An app that can restore the storage of its older versions (see App::Migrate)
+#define DECLARE_MIGRATING_APP(a, b, name, prefix) { APP_FUNCTIONS(a, b, name, prefix), prefix ## _migrate }
 
 OC::App available_apps[] = {
-  DECLARE_APP('H','S', "Hemisphere", HEMISPHERE),
+  DECLARE_MIGRATING_APP('H','S', "Hemisphere", HEMISPHERE),
   DECLARE_APP('M','I', "Captain MIDI", MIDI),
   DECLARE_APP('D','2', "Darkest Timeline", TheDarkestTimeline),
   DECLARE_APP('E','N', "Enigma", EnigmaTMWS),
@@ -110,8 +116,8 @@ void save_global_settings() {
   // scaling settings:
   global_settings.DAC_scaling = OC::DAC::store_scaling();
   
-  global_settings_storage.Save(global_settings);
-  SERIAL_PRINTLN("Saved global settings: page_index %d", global_settings_storage.page_index());
+  global_settings_storage.BeginSave(global_settings);
+  SERIAL_PRINTLN("Saving global settings: page_index %d", global_settings_storage.page_index());
 }
 
 void save_app_data() {
@@ -145,8 +151,8 @@ void save_app_data() {
     }
   }
   SERIAL_PRINTLN("App settings used: %u/%u", app_settings.used, EEPROM_APPDATA_BINARY_SIZE);
-  app_data_storage.Save(app_settings);
-  SERIAL_PRINTLN("Saved app settings in page_index %d", app_data_storage.page_index());
+  app_data_storage.BeginSave(app_settings);
+  SERIAL_PRINTLN("Saving app settings in page_index %d", app_data_storage.page_index());
 }
 
 void restore_app_data() {
@@ -174,7 +180,13 @@ void restore_app_data() {
     size_t expected_length = app->storageSize() + sizeof(AppChunkHeader);
     if (expected_length & 0x1) ++expected_length;
     if (chunk->length != expected_length) {
-      SERIAL_PRINTLN("* %s (%02x): chunk length %u != %u (storageSize=%u), skipping...", app->name, chunk->id, chunk->length, expected_length, app->storageSize());
+      if (app->Migrate) {
+        SERIAL_PRINTLN("* %s (%02x): chunk length %u != %u (storageSize=%u), migrating...", app->name, chunk->id, chunk->length, expected_length, app->storageSize());
+        app->Migrate(chunk + 1, chunk->length - sizeof(AppChunkHeader));
+        restored_bytes += chunk->length;
+      } else {
+        SERIAL_PRINTLN("* %s (%02x): chunk length %u != %u (storageSize=%u), skipping...", app->name, chunk->id, chunk->length, expected_length, app->storageSize());
+      }
       data += chunk->length;
       continue;
     }
@@ -198,6 +210,7 @@ namespace apps {
 void set_current_app(int index) {
   current_app = &available_apps[index];
   global_settings.current_app_id = current_app->id;
+  frame_pacing.set_frame_rate(OC_FRAME_RATE_DEFAULT);
 }
 
 App *current_app = &available_apps[DEFAULT_APP_INDEX];
@@ -296,6 +309,43 @@ void Init(bool reset_settings) {
   delay(100);
 }
 
+static bool saving = false;
+static size_t save_length = 0;
+
+void Save() {
+  save_global_settings();
+  save_app_data();
+  save_length = global_settings_storage.save_remaining() + app_data_storage.save_remaining();
+  saving = save_length > 0;
+}
+
+bool SaveStep() {
+  if (saving &&
+      !global_settings_storage.SaveStep(SETTINGS_SAVE_WRITES_PER_LOOP) &&
+      !app_data_storage.SaveStep(SETTINGS_SAVE_WRITES_PER_LOOP)) {
+    SERIAL_PRINTLN("Saved settings: page_index %d, %d",
+                   global_settings_storage.page_index(), app_data_storage.page_index());
+    saving = false;
+  }
+  return saving;
+}
+
+bool save_pending() {
+  return saving;
+}
+
+uint32_t save_progress() {
+  if (!saving)
+    return 100;
+  const size_t remaining = global_settings_storage.save_remaining() + app_data_storage.save_remaining();
+  return (save_length - remaining) * 100 / save_length;
+}
+
+void DrawSaveProgress() {
+  if (saving)
+    graphics.invertRect(0, 63, 1 + save_progress() * 127 / 100, 1);
+}
+
 }; // namespace apps
 
 void draw_app_menu(const menu::ScreenCursor<5> &cursor) {
@@ -322,15 +372,6 @@ void draw_app_menu(const menu::ScreenCursor<5> &cursor) {
   GRAPHICS_END_FRAME();
 }
 
-void draw_save_message(uint8_t c) {
-  GRAPHICS_BEGIN_FRAME(true);
-  uint8_t _size = c % 120;
-  graphics.setPrintPos(37, 18);
-  graphics.print("Saving...");
-  graphics.drawRect(0, 28, _size, 8);
-  GRAPHICS_END_FRAME();
-}
-
 void Ui::AppSettings() {
 
   SetButtonIgnoreMask();
@@ -376,16 +417,11 @@ void Ui::AppSettings() {
 
   if (change_app) {
     apps::set_current_app(cursor.cursor_pos());
+    OC::midi_input.Flush();
     FreqMeasure.end();
     OC::DigitalInputs::reInit();
-    if (save) {
-      save_global_settings();
-      save_app_data();
-      // draw message:
-      int cnt = 0;
-      while(idle_time() < SETTINGS_SAVE_TIMEOUT_MS)
-        draw_save_message((cnt++) >> 4);
-    }
+    if (save)
+      apps::Save();
   }
 
   OC::ui.encoders_enable_acceleration(global_settings.encoders_enable_acceleration);
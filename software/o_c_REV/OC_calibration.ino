@@ -66,6 +66,7 @@ void calibration_reset() {
     OC::calibration_data.dac.calibrated_octaves[2][i] += DAC_OFFSET;
     OC::calibration_data.dac.calibrated_octaves[3][i] += DAC_OFFSET;
   }
+  OC::DAC::calibration_data_changed();
 }
 
 void calibration_load() {
@@ -97,6 +98,8 @@ void calibration_load() {
 
   if (!OC::calibration_data.screensaver_timeout)
     OC::calibration_data.screensaver_timeout = SCREENSAVER_TIMEOUT_S;
+
+  OC::DAC::calibration_data_changed();
 }
 
 void calibration_save() {
@@ -553,6 +556,7 @@ void calibration_update(CalibrationState &state) {
     case CALIBRATE_OCTAVE:
       OC::calibration_data.dac.calibrated_octaves[step_to_channel(step->step)][step->index + DAC::kOctaveZero] =
         state.encoder_value;
+      DAC::calibration_data_changed();
       DAC::set_all_octave(step->index);
       break;
     case CALIBRATE_ADC_OFFSET:
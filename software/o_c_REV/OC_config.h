@@ -19,7 +19,9 @@ static constexpr int OC_CORE_TIMER_PRIO = 80;  // yet higher
 static constexpr int OC_GPIO_ISR_PRIO   = 112; // higher
 static constexpr int OC_UI_TIMER_PRIO   = 128; // default
 
-static constexpr unsigned long REDRAW_TIMEOUT_MS = 1;
+// Main loop redraw rate (\sa OC_frame_pacing.h); the SH1106 panel itself
+// refreshes at about 100Hz, so there's no point in going faster
+static constexpr uint32_t OC_FRAME_RATE_DEFAULT = 100;
 static constexpr uint32_t SCREENSAVER_TIMEOUT_S = 25; // default time out menu (in s)
 static constexpr uint32_t SCREENSAVER_TIMEOUT_MAX_S = 120;
 
@@ -27,13 +29,21 @@ namespace OC {
 static constexpr size_t kMaxTriggerDelayTicks = 96;
 };
 
+// MIDI input ring (\sa OC_midi_input.h) and the most messages read per tick
+static constexpr uint32_t OC_MIDI_INPUT_EVENTS = 32;
+static constexpr uint32_t OC_MIDI_INPUT_MAX_PER_TICK = 16;
+
+// Tempo range of the MIDI clock PLL (\sa util_clock_pll.h), in ticks per 24 ppqn pulse
+static constexpr uint32_t OC_MIDI_CLOCK_MIN_PERIOD = 60000000UL / OC_CORE_TIMER_RATE / 24 / 400; // 400 BPM
+static constexpr uint32_t OC_MIDI_CLOCK_MAX_PERIOD = 60000000UL / OC_CORE_TIMER_RATE / 24 / 8; // 8 BPM
+
 #define OCTAVES 10      // # octaves
 #define SEMITONES (OCTAVES * 12)
 
 static constexpr unsigned long SPLASHSCREEN_DELAY_MS = 100; // HS deprecates splash screen, but keep a slight delay
 
 static constexpr unsigned long APP_SELECTION_TIMEOUT_MS = 25000;
-static constexpr unsigned long SETTINGS_SAVE_TIMEOUT_MS = 1000;
+static constexpr size_t SETTINGS_SAVE_WRITES_PER_LOOP = 8;
 
 #define EEPROM_CALIBRATIONDATA_START 0
 #define EEPROM_CALIBRATIONDATA_END 128
@@ -72,5 +82,7 @@ static constexpr unsigned long SETTINGS_SAVE_TIMEOUT_MS = 1000;
 /* ------------ uncomment line below to enable QQ debug page ----------------------------------------- */
 //#define QQ_DEBUG
 //#define QQ_DEBUG_SCREENSAVER
+/* ------------ uncomment line below to enable per-applet cycle counters (APPLETS page, ~7k RAM) ----- */
+//#define HEMISPHERE_PROFILING
 
 #endif // OC_CONFIG_H_
@@ -3,9 +3,12 @@
 #include "OC_config.h"
 #include "OC_core.h"
 #include "OC_debug.h"
+#include "OC_frame_pacing.h"
 #include "OC_menus.h"
+#include "OC_midi_input.h"
 #include "OC_ui.h"
 #include "util/util_misc.h"
+#include "util/util_ringbuffer.h"
 #include "extern/dspinst.h"
 
 #ifdef POLYLFO_DEBUG  
@@ -36,19 +39,117 @@ extern void QQ_debug();
 extern void ASR_debug();
 #endif // ASR_DEBUG
 
+#ifdef HEMISPHERE_PROFILING
+extern void HEMISPHERE_debug();
+extern void HEMISPHERE_debug_reset();
+extern void HEMISPHERE_debug_dump();
+#endif // HEMISPHERE_PROFILING
+
 namespace OC {
 
 namespace DEBUG {
   debug::AveragedCycles ISR_cycles;
   debug::AveragedCycles UI_cycles;
   debug::AveragedCycles MENU_draw_cycles;
+  debug::HistogramCycles DISPLAY_cycles;
+  debug::HistogramCycles DAC_cycles;
+  debug::HistogramCycles ADC_cycles;
+  volatile uint8_t ISR_trace_applet_ids[2];
+  volatile uint32_t ISR_overruns;
+  volatile uint32_t ISR_missed_ticks;
   uint32_t UI_event_count;
   uint32_t UI_max_queue_depth;
   uint32_t UI_queue_overflow;
 
+  static util::RingBuffer<IsrTrace, kIsrTraceSize> isr_trace;
+  static uint32_t isr_last_start;
+
   void Init() {
     debug::CycleMeasurement::Init();
     DebugPins::Init();
+    isr_trace.Init();
+  }
+
+  static inline uint16_t saturate_u16(uint32_t value) {
+    return value > 0xffff ? 0xffff : value;
+  }
+
+  void FASTRUN IsrDone(const IsrTimeline &timeline, uint32_t tick, uint16_t app_id) {
+    const uint32_t *stages = timeline.stages;
+    DISPLAY_cycles.push(stages[ISR_STAGE_DISPLAY_FLUSH] + stages[ISR_STAGE_DISPLAY_UPDATE] - stages[ISR_STAGE_DAC]);
+    DAC_cycles.push(stages[ISR_STAGE_DAC] - stages[ISR_STAGE_DISPLAY_FLUSH]);
+    ADC_cycles.push(stages[ISR_STAGE_ADC] - stages[ISR_STAGE_DISPLAY_UPDATE]);
+
+    // A period of 1.5x the timer rate or more means at least one tick was
+    // lost; the first ISR has no reference.
+    uint32_t period = timeline.start - isr_last_start;
+    isr_last_start = timeline.start;
+    uint32_t missed = 0;
+    if (tick > 1 && period >= kIsrBudgetCycles + kIsrBudgetCycles / 2)
+      missed = (period + kIsrBudgetCycles / 2) / kIsrBudgetCycles - 1;
+
+    if (missed || stages[ISR_STAGE_APP] > kIsrBudgetCycles) {
+      ++ISR_overruns;
+      ISR_missed_ticks += missed;
+
+      IsrTrace trace;
+      trace.tick = tick;
+      trace.period = period;
+      for (int s = 0; s < ISR_STAGE_LAST; ++s)
+        trace.stages[s] = saturate_u16(stages[s]);
+      trace.app_id = app_id;
+      trace.applet_ids[0] = ISR_trace_applet_ids[0];
+      trace.applet_ids[1] = ISR_trace_applet_ids[1];
+      isr_trace.Write(trace); // Overwrites oldest
+    }
+  }
+
+  bool GetIsrTrace(size_t n, IsrTrace &trace) {
+    if (n >= kIsrTraceSize || n >= ISR_overruns)
+      return false;
+    __disable_irq();
+    trace = isr_trace.Poke(n);
+    __enable_irq();
+    return true;
+  }
+
+  void ResetIsrTrace() {
+    __disable_irq();
+    ISR_overruns = 0;
+    ISR_missed_ticks = 0;
+    isr_trace.Init();
+    __enable_irq();
+  }
+
+  void DumpIsrTrace() {
+    serial_printf("ISR overruns %lu, missed ticks %lu, budget %lu cycles\n",
+                  (unsigned long)ISR_overruns, (unsigned long)ISR_missed_ticks,
+                  (unsigned long)kIsrBudgetCycles);
+    serial_printf("tick,period,flush,dac,update,adc,digital,app,app_id,applet_l,applet_r\n");
+    IsrTrace trace;
+    for (size_t n = kIsrTraceSize; n--; ) {
+      if (!GetIsrTrace(n, trace))
+        continue;
+      serial_printf("%lu,%lu,%u,%u,%u,%u,%u,%u,%c%c,%u,%u\n",
+                    (unsigned long)trace.tick, (unsigned long)trace.period,
+                    trace.stages[ISR_STAGE_DISPLAY_FLUSH], trace.stages[ISR_STAGE_DAC],
+                    trace.stages[ISR_STAGE_DISPLAY_UPDATE], trace.stages[ISR_STAGE_ADC],
+                    trace.stages[ISR_STAGE_DIGITAL_INPUTS], trace.stages[ISR_STAGE_APP],
+                    trace.app_id >> 8, trace.app_id & 0xff,
+                    trace.applet_ids[0], trace.applet_ids[1]);
+    }
+  }
+
+  void DrawHistogram(int x, int y, int height, const debug::HistogramCycles &histogram) {
+    for (int b = 0; b < debug::HistogramCycles::kBuckets; ++b, x += 3) {
+      uint32_t count = histogram.bucket(b);
+      if (count) {
+        int h = ((32 - __builtin_clz(count)) * height + 15) / 16;
+        graphics.drawRect(x, y + height - h, 2, h);
+      } else {
+        graphics.drawHLine(x, y + height - 1, 2);
+      }
+    }
   }
 }; // namespace DEBUG
 
@@ -79,6 +180,20 @@ static void debug_menu_core() {
 }
 
 static void debug_menu_gfx() {
+  // Pages and frames sent to the display in the last second
+  static uint32_t last_millis, last_pages, last_frames;
+  static uint32_t pages_per_second, frames_per_second;
+  const uint32_t now = millis();
+  if (now - last_millis >= 1000) {
+    const uint32_t pages = display::driver.pages_sent();
+    const uint32_t frames = display::driver.frames_sent();
+    pages_per_second = (pages - last_pages) * 1000 / (now - last_millis);
+    frames_per_second = (frames - last_frames) * 1000 / (now - last_millis);
+    last_millis = now;
+    last_pages = pages;
+    last_frames = frames;
+  }
+
   graphics.drawFrame(0, 0, 128, 64);
 
   graphics.setPrintPos(0, 12);
@@ -89,6 +204,57 @@ static void debug_menu_gfx() {
                   debug::cycles_to_us(DEBUG::MENU_draw_cycles.min_value()),
                   debug::cycles_to_us(DEBUG::MENU_draw_cycles.value()),
                   debug::cycles_to_us(DEBUG::MENU_draw_cycles.max_value()));
+
+  graphics.setPrintPos(2, 32);
+  graphics.printf("PAGE %4lu/s %3lu fps", pages_per_second, frames_per_second);
+
+  // Main loop redraws of the app, latched before the app menu was entered
+  graphics.setPrintPos(2, 42);
+  graphics.printf("FPS %3lu/%3lu IDLE %2lu%%",
+                  frame_pacing.fps(), frame_pacing.frame_rate(), frame_pacing.idle_percent());
+}
+
+static void debug_menu_stages() {
+  const struct {
+    const char *name;
+    const debug::HistogramCycles &cycles;
+  } stages[] = {
+    { "DISP", DEBUG::DISPLAY_cycles },
+    { "DAC ", DEBUG::DAC_cycles },
+    { "ADC ", DEBUG::ADC_cycles },
+  };
+
+  for (size_t i = 0; i < ARRAY_SIZE(stages); ++i) {
+    graphics.setPrintPos(2, 12 + i * 10);
+    graphics.printf("%s%3u/%3u/%3u",
+                    stages[i].name,
+                    debug::cycles_to_us(stages[i].cycles.min_value()),
+                    debug::cycles_to_us(stages[i].cycles.value()),
+                    debug::cycles_to_us(stages[i].cycles.max_value()));
+    DEBUG::DrawHistogram(2 + i * 42, 45, 16, stages[i].cycles);
+  }
+}
+
+static void debug_reset_stages() {
+  DEBUG::DISPLAY_cycles.Reset();
+  DEBUG::DAC_cycles.Reset();
+  DEBUG::ADC_cycles.Reset();
+}
+
+static void debug_menu_overruns() {
+  graphics.setPrintPos(2, 12);
+  graphics.printf("OVR %lu MISS %lu", DEBUG::ISR_overruns, DEBUG::ISR_missed_ticks);
+
+  // Latest overruns: tick, ISR time, app, applets
+  DEBUG::IsrTrace trace;
+  for (size_t n = 0; n < 4 && DEBUG::GetIsrTrace(n, trace); ++n) {
+    graphics.setPrintPos(2, 22 + n * 10);
+    graphics.printf("%7lu%4u %c%c%3u%4u",
+                    trace.tick % 10000000,
+                    debug::cycles_to_us(trace.stages[DEBUG::ISR_STAGE_APP]),
+                    trace.app_id >> 8, trace.app_id & 0xff,
+                    trace.applet_ids[0], trace.applet_ids[1]);
+  }
 }
 
 static void debug_menu_adc() {
@@ -110,15 +276,54 @@ static void debug_menu_adc() {
 //      graphics.setPrintPos(2, 52); graphics.print(ADC::fail_flag1());
 }
 
+static void debug_menu_midi() {
+  graphics.setPrintPos(2, 12);
+  graphics.printf("IN %lu", midi_input.written());
+
+  // Most messages drained before USB was empty, and ticks before an event was read
+  graphics.setPrintPos(2, 22);
+  graphics.printf("BACKLOG %3lu", midi_input.backlog_max());
+  graphics.setPrintPos(2, 32);
+  graphics.printf("LATENCY %3lu ticks", midi_input.latency_max());
+  graphics.setPrintPos(2, 42);
+  graphics.printf("LOST %lu", midi_input.lost());
+
+  // Clock PLL, and the average difference between predicted and actual pulses
+  const util::ClockPll &clock = midi_input.clock();
+  graphics.setPrintPos(2, 52);
+  graphics.printf("CLK %s JITTER %4luus",
+                  clock.locked(OC::CORE::ticks) ? "LOCK" : "----",
+                  (clock.jitter() * OC_CORE_TIMER_RATE) >> util::ClockPll::kShift);
+}
+
+static void debug_reset_midi() {
+  midi_input.ResetStats();
+}
+
+// Optional reset_fn and dump_fn are called on the down and up buttons
 struct DebugMenu {
   const char *title;
   void (*display_fn)();
+  void (*reset_fn)();
+  void (*dump_fn)();
 };
 
+#ifdef HEMISPHERE_PROFILING
+#define DEBUG_PROFILE_DUMP HEMISPHERE_debug_dump
+#else
+#define DEBUG_PROFILE_DUMP nullptr
+#endif
+
 static const DebugMenu debug_menus[] = {
   { " CORE", debug_menu_core },
+  { " STAGES", debug_menu_stages, debug_reset_stages, DEBUG_PROFILE_DUMP },
+  { " OVERRUN", debug_menu_overruns, DEBUG::ResetIsrTrace, DEBUG::DumpIsrTrace },
+#ifdef HEMISPHERE_PROFILING
+  { " APPLETS", HEMISPHERE_debug, HEMISPHERE_debug_reset, HEMISPHERE_debug_dump },
+#endif // HEMISPHERE_PROFILING
   { " GFX", debug_menu_gfx },
   { " ADC", debug_menu_adc },
+  { " MIDI", debug_menu_midi, debug_reset_midi },
 #ifdef POLYLFO_DEBUG  
   { " POLYLFO", POLYLFO_debug },
 #endif // POLYLFO_DEBUG
@@ -140,7 +345,7 @@ static const DebugMenu debug_menus[] = {
 #ifdef ASR_DEBUG  
   { " ASR", ASR_debug },
 #endif // ASR_DEBUG
- { nullptr, nullptr }
+ { nullptr, nullptr, nullptr, nullptr }
 };
 
 void Ui::DebugStats() {
@@ -165,6 +370,12 @@ void Ui::DebugStats() {
         ++current_menu;
         if (!current_menu->title || !current_menu->display_fn)
           current_menu = &debug_menus[0];
+      } else if (CONTROL_BUTTON_DOWN == event.control && UI::EVENT_BUTTON_PRESS == event.type) {
+        if (current_menu->reset_fn)
+          current_menu->reset_fn();
+      } else if (CONTROL_BUTTON_UP == event.control && UI::EVENT_BUTTON_PRESS == event.type) {
+        if (current_menu->dump_fn)
+          current_menu->dump_fn();
       }
     }
   }
@@ -1,6 +1,7 @@
 #ifndef OC_DEBUG_H_
 #define OC_DEBUG_H_
 
+#include "OC_config.h"
 #include "OC_gpio.h"
 #include "util/util_math.h"
 #include "util/util_macros.h"
@@ -16,6 +17,65 @@ namespace DEBUG {
   extern debug::AveragedCycles UI_cycles;
   extern debug::AveragedCycles MENU_draw_cycles;
 
+  // Core ISR stages; DISPLAY is Flush + Update
+  extern debug::HistogramCycles DISPLAY_cycles;
+  extern debug::HistogramCycles DAC_cycles;
+  extern debug::HistogramCycles ADC_cycles;
+
+  // Core ISR overrun detection
+  // The ISR marks the end of each stage in an IsrTimeline and hands it to
+  // IsrDone. If the ISR took longer than the timer period, or the time since
+  // the previous ISR shows that ticks were missed, the timeline is kept in a
+  // small trace ring along with the active app and applet ids.
+  enum IsrStage {
+    ISR_STAGE_DISPLAY_FLUSH,
+    ISR_STAGE_DAC,
+    ISR_STAGE_DISPLAY_UPDATE,
+    ISR_STAGE_ADC,
+    ISR_STAGE_DIGITAL_INPUTS,
+    ISR_STAGE_APP,
+    ISR_STAGE_LAST
+  };
+
+  static constexpr uint32_t kIsrBudgetCycles = OC_CORE_TIMER_RATE * (F_CPU / 1000000);
+  static constexpr size_t kIsrTraceSize = 16;
+
+  struct IsrTimeline {
+    IsrTimeline() : start(ARM_DWT_CYCCNT) { }
+
+    inline void mark(IsrStage stage) {
+      stages[stage] = ARM_DWT_CYCCNT - start;
+    }
+
+    uint32_t start;
+    uint32_t stages[ISR_STAGE_LAST];
+  };
+
+  struct IsrTrace {
+    uint32_t tick;
+    uint32_t period; // Cycles since the previous ISR started
+    uint16_t stages[ISR_STAGE_LAST]; // End of each stage, cycles since ISR start
+    uint16_t app_id;
+    uint8_t applet_ids[2];
+  };
+
+  void IsrDone(const IsrTimeline &timeline, uint32_t tick, uint16_t app_id);
+
+  // Set by apps that run sub-programs (i.e. Hemisphere) for the trace
+  extern volatile uint8_t ISR_trace_applet_ids[2];
+
+  extern volatile uint32_t ISR_overruns;
+  extern volatile uint32_t ISR_missed_ticks;
+
+  // Copy the nth most recent overrun (0 = latest); returns false if there is
+  // no such entry
+  bool GetIsrTrace(size_t n, IsrTrace &trace);
+  void ResetIsrTrace();
+  void DumpIsrTrace();
+
+  // Draw log2 histogram bars (3px pitch), with bar height ~ log2(count)
+  void DrawHistogram(int x, int y, int height, const debug::HistogramCycles &histogram);
+
   extern uint32_t UI_event_count;
   extern uint32_t UI_max_queue_depth;
   extern uint32_t UI_queue_overflow;
@@ -35,7 +95,7 @@ public:
 
 
 #define OC_DEBUG_PROFILE_SCOPE(var) \
-  debug::ScopedCycleMeasurement cycles(var)
+  debug::ScopedCycleMeasurement<decltype(var)> cycles(var)
 
 #define OC_DEBUG_RESET_CYCLES(counter, count, var) \
   do { \
@@ -8,7 +8,25 @@
 uint32_t OC::DigitalInputs::clocked_mask_;
 
 /*static*/
-volatile uint32_t OC::DigitalInputs::clocked_[DIGITAL_INPUT_LAST];
+uint32_t OC::DigitalInputs::scan_cycles_;
+
+/*static*/
+volatile uint32_t OC::DigitalInputs::edge_fifo_[DIGITAL_INPUT_LAST][kEdgeFifoLength];
+
+/*static*/
+volatile uint32_t OC::DigitalInputs::edge_writes_[DIGITAL_INPUT_LAST];
+
+/*static*/
+uint32_t OC::DigitalInputs::edge_reads_[DIGITAL_INPUT_LAST];
+
+/*static*/
+uint32_t OC::DigitalInputs::edges_[DIGITAL_INPUT_LAST];
+
+/*static*/
+uint32_t OC::DigitalInputs::edge_cycles_[DIGITAL_INPUT_LAST];
+
+/*static*/
+uint32_t OC::DigitalInputs::period_cycles_[DIGITAL_INPUT_LAST];
 
 void FASTRUN tr1_ISR() {  
   OC::DigitalInputs::clock<OC::DIGITAL_INPUT_1>();
@@ -45,12 +63,17 @@ void OC::DigitalInputs::Init() {
   }
 
   clocked_mask_ = 0;
-  std::fill(clocked_, clocked_ + DIGITAL_INPUT_LAST, 0);
+  scan_cycles_ = ARM_DWT_CYCCNT;
+  for (size_t input = 0; input < DIGITAL_INPUT_LAST; ++input) {
+    edge_writes_[input] = edge_reads_[input] = 0;
+    edges_[input] = period_cycles_[input] = 0;
+    edge_cycles_[input] = scan_cycles_;
+  }
 
-  // Assume the priority of pin change interrupts is lower or equal to the
-  // thread where ::Scan function is called. Otherwise a safer mechanism is
-  // required to avoid conflicts (LDREX/STREX or store ARM_DWT_CYCCNT in the
-  // array to check for changes.
+  // The pin ISRs only ever write the edge FIFO and bump the write count, and
+  // Scan only reads up to its snapshot of that count, so it doesn't matter
+  // whether they preempt the thread where ::Scan is called (TR1 does, see
+  // setup()).
   //
   // A really nice approach would be to use the FTM timer mechanism and avoid
   // the ISR altogether, but this only works for one of the pins. Using more
@@ -78,6 +101,7 @@ void OC::DigitalInputs::reInit() {
 
 /*static*/
 void OC::DigitalInputs::Scan() {
+  scan_cycles_ = ARM_DWT_CYCCNT;
   clocked_mask_ =
     ScanInput<DIGITAL_INPUT_1>() |
     ScanInput<DIGITAL_INPUT_2>() |
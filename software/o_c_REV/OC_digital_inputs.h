@@ -29,9 +29,15 @@ template <> struct InputPinDesc<DIGITAL_INPUT_2> { static constexpr int PIN = TR
 template <> struct InputPinDesc<DIGITAL_INPUT_3> { static constexpr int PIN = TR3; };
 template <> struct InputPinDesc<DIGITAL_INPUT_4> { static constexpr int PIN = TR4; };
 
+// Each pin ISR timestamps its edge with ARM_DWT_CYCCNT into a small per-input
+// FIFO, so Scan() can count every edge since the last tick (not just flag
+// that there was one) and time clocks to the cycle rather than to the tick.
 class DigitalInputs {
 public:
 
+  static constexpr size_t kEdgeFifoLength = 8; // power of two
+  static constexpr uint32_t kCyclesPerTick = F_CPU / OC_CORE_ISR_FREQ;
+
   static void Init();
 
   static void reInit();
@@ -61,8 +67,38 @@ public:
     return !digitalReadFast(InputPinMap(input));
   }
 
+  // @return number of edges on input since the previous Scan()
+  static inline uint32_t edges(DigitalInput input) {
+    return edges_[input];
+  }
+
+  // @return cycles between the last two edges on input
+  static inline uint32_t period_cycles(DigitalInput input) {
+    return period_cycles_[input];
+  }
+
+  // @return ARM_DWT_CYCCNT at the last edge on input
+  static inline uint32_t edge_cycles(DigitalInput input) {
+    return edge_cycles_[input];
+  }
+
+  // @return ARM_DWT_CYCCNT at the last Scan()
+  static inline uint32_t scan_cycles() {
+    return scan_cycles_;
+  }
+
+  // @return how long before the last Scan() the last edge on input came, in
+  // 1/65536 ticks (saturates at one tick)
+  static inline uint32_t edge_tick_offset(DigitalInput input) {
+    uint32_t cycles = scan_cycles_ - edge_cycles_[input];
+    if (cycles > kCyclesPerTick) cycles = kCyclesPerTick;
+    return (cycles << 16) / kCyclesPerTick;
+  }
+
   template <DigitalInput input> static inline void clock() {
-    clocked_[input] = 1;
+    const uint32_t count = edge_writes_[input];
+    edge_fifo_[input][count & (kEdgeFifoLength - 1)] = ARM_DWT_CYCCNT;
+    edge_writes_[input] = count + 1;
   }
 
 private:
@@ -79,16 +115,33 @@ private:
   }
 
   static uint32_t clocked_mask_;
-  static volatile uint32_t clocked_[DIGITAL_INPUT_LAST];
+  static uint32_t scan_cycles_;
+
+  // Written by the pin ISRs
+  static volatile uint32_t edge_fifo_[DIGITAL_INPUT_LAST][kEdgeFifoLength];
+  static volatile uint32_t edge_writes_[DIGITAL_INPUT_LAST];
 
+  static uint32_t edge_reads_[DIGITAL_INPUT_LAST];
+  static uint32_t edges_[DIGITAL_INPUT_LAST];
+  static uint32_t edge_cycles_[DIGITAL_INPUT_LAST];
+  static uint32_t period_cycles_[DIGITAL_INPUT_LAST];
+
+  // The pin ISR may preempt this, so only edges before the snapshot of the
+  // write count are used (their timestamps are already in the FIFO).
   template <DigitalInput input>
   static uint32_t ScanInput() {
-    if (clocked_[input]) {
-      clocked_[input] = 0;
-      return DIGITAL_INPUT_MASK(input);
-    } else {
+    const uint32_t writes = edge_writes_[input];
+    const uint32_t edges = writes - edge_reads_[input];
+    edge_reads_[input] = writes;
+    edges_[input] = edges;
+    if (!edges)
       return 0;
-    }
+
+    const uint32_t last = edge_fifo_[input][(writes - 1) & (kEdgeFifoLength - 1)];
+    const uint32_t previous = edges > 1 ? edge_fifo_[input][(writes - 2) & (kEdgeFifoLength - 1)] : edge_cycles_[input];
+    period_cycles_[input] = last - previous;
+    edge_cycles_[input] = last;
+    return DIGITAL_INPUT_MASK(input);
   }
 };
 
@@ -0,0 +1,115 @@
+#ifndef OC_FRAME_PACING_H_
+#define OC_FRAME_PACING_H_
+
+#include <Arduino.h>
+#include "OC_config.h"
+#include "src/drivers/display.h"
+
+namespace OC {
+
+// Frame governor for the main loop redraw.
+//
+// A frame is drawn at most at the target rate, and only once the display has
+// taken the previous one, so the loop doesn't render frames that would never
+// be seen. Input events request a redraw, which skips the wait for the next
+// frame time. The rate is reset to OC_FRAME_RATE_DEFAULT when the app changes;
+// apps that animate faster or slower can set their own on APP_EVENT_RESUME.
+//
+// Once per second it also latches the achieved frame rate and the share of
+// main loop time not spent drawing frames, for the debug menu. Time in ISRs
+// that preempt a frame counts as drawing.
+class FramePacing {
+public:
+  static constexpr uint32_t kStatsWindowUs = 1000000;
+
+  void Init() {
+    set_frame_rate(OC_FRAME_RATE_DEFAULT);
+    redraw_requested_ = true;
+    last_frame_us_ = window_start_us_ = micros();
+    window_frames_ = window_busy_cycles_ = 0;
+    fps_ = 0;
+    idle_percent_ = 100;
+  }
+
+  // A rate of 0 is taken as 1
+  void set_frame_rate(uint32_t fps) {
+    if (!fps) fps = 1;
+    frame_rate_ = fps;
+    frame_period_us_ = 1000000UL / fps;
+  }
+
+  uint32_t frame_rate() const {
+    return frame_rate_;
+  }
+
+  void RequestRedraw() {
+    redraw_requested_ = true;
+  }
+
+  // @return true if a frame should be drawn now; a frame buffer is then
+  // guaranteed to be writeable
+  bool frame_due() {
+    const uint32_t now = micros();
+    if (now - window_start_us_ >= kStatsWindowUs)
+      LatchStats(now);
+
+    if (!display::frame_buffer.writeable())
+      return false;
+    if (redraw_requested_)
+      return true;
+    return !display::frame_buffer.readable() && now - last_frame_us_ >= frame_period_us_;
+  }
+
+  // Advances the frame time by one period, unless the frame was requested or
+  // the loop fell behind by more than a frame
+  void FrameDrawn(uint32_t cycles) {
+    const uint32_t now = micros();
+    if (redraw_requested_ || now - last_frame_us_ >= 2 * frame_period_us_)
+      last_frame_us_ = now;
+    else
+      last_frame_us_ += frame_period_us_;
+    redraw_requested_ = false;
+
+    ++window_frames_;
+    window_busy_cycles_ += cycles;
+  }
+
+  uint32_t fps() const {
+    return fps_;
+  }
+
+  uint32_t idle_percent() const {
+    return idle_percent_;
+  }
+
+private:
+  uint32_t frame_rate_;
+  uint32_t frame_period_us_;
+  bool redraw_requested_;
+  uint32_t last_frame_us_;
+
+  uint32_t window_start_us_;
+  uint32_t window_frames_;
+  uint32_t window_busy_cycles_;
+  uint32_t fps_;
+  uint32_t idle_percent_;
+
+  // A window much longer than a second means the loop was stopped (e.g. in
+  // the app menu), so it's dropped instead of reported
+  void LatchStats(uint32_t now) {
+    const uint32_t elapsed_us = now - window_start_us_;
+    if (elapsed_us < 2 * kStatsWindowUs) {
+      fps_ = (window_frames_ * 1000000ULL + elapsed_us / 2) / elapsed_us;
+      const uint32_t busy_percent = window_busy_cycles_ / (elapsed_us * (F_CPU / 1000000) / 100);
+      idle_percent_ = busy_percent < 100 ? 100 - busy_percent : 0;
+    }
+    window_start_us_ = now;
+    window_frames_ = window_busy_cycles_ = 0;
+  }
+};
+
+extern FramePacing frame_pacing;
+
+}; // namespace OC
+
+#endif // OC_FRAME_PACING_H_
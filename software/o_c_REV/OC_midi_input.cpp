@@ -0,0 +1,70 @@
+#include <Arduino.h>
+#include "OC_midi_input.h"
+
+namespace OC {
+
+MidiInput midi_input;
+
+static constexpr uint8_t kSysExType = 7;
+static constexpr uint8_t kFirstSystemType = 7; // SysEx and realtime have no channel
+static constexpr uint8_t kRealTimeType = 8;
+
+// Real-time data1, the status byte - 0xf8
+static constexpr uint8_t kRealTimeClock = 0;
+static constexpr uint8_t kRealTimeStart = 2;
+static constexpr uint8_t kRealTimeContinue = 3;
+static constexpr uint8_t kRealTimeStop = 4;
+
+void MidiInput::Init() {
+  written_ = flushed_ = 0;
+  stall_ = false;
+  backlogged_ = false;
+  backlog_ = 0;
+  clock_.Init(OC_MIDI_CLOCK_MIN_PERIOD, OC_MIDI_CLOCK_MAX_PERIOD);
+  ResetStats();
+}
+
+void FASTRUN MidiInput::Drain() {
+  const uint32_t now = OC::CORE::ticks;
+  if (stall_) {
+    stall_ = false;
+    Backlog(now);
+    return;
+  }
+
+  const uint32_t seen = backlogged_ ? backlog_since_ : now;
+  uint32_t written = written_;
+  uint32_t drained = 0;
+  bool more = false; // Stopped before the USB buffer was empty?
+  while (!more && usbMIDI.read()) {
+    MidiEvent &event = events_[written & (kEvents - 1)];
+    event.type = usbMIDI.getType();
+    event.channel = event.type < kFirstSystemType ? usbMIDI.getChannel() : 0;
+    event.data1 = usbMIDI.getData1();
+    event.data2 = usbMIDI.getData2();
+    event.tick = seen;
+    ++written;
+    ++drained;
+    if (event.type == kRealTimeType) {
+      switch (event.data1) {
+        case kRealTimeClock: clock_.Pulse(now); break;
+        case kRealTimeStart: clock_.Start(); break;
+        case kRealTimeContinue: clock_.Continue(); break;
+        case kRealTimeStop: clock_.Stop(); break;
+      }
+    }
+    more = event.type == kSysExType || drained >= OC_MIDI_INPUT_MAX_PER_TICK;
+  }
+  written_ = written;
+
+  backlog_ += drained;
+  if (backlog_ > backlog_max_) backlog_max_ = backlog_;
+  if (more) {
+    Backlog(now);
+  } else {
+    backlogged_ = false;
+    backlog_ = 0;
+  }
+}
+
+}; // namespace OC
@@ -0,0 +1,175 @@
+#ifndef OC_MIDI_INPUT_H_
+#define OC_MIDI_INPUT_H_
+
+#include <stdint.h>
+#include "OC_config.h"
+#include "OC_core.h"
+#include "util/util_clock_pll.h"
+
+namespace OC {
+
+// A message read from usbMIDI. The type is as returned by usbMIDI.getType()
+// (see MIDI_MSG_* in HSMIDI.h), and the channel is 1-16 for channel messages.
+struct MidiEvent {
+  uint8_t type;
+  uint8_t channel;
+  uint8_t data1;
+  uint8_t data2;
+  uint32_t tick; // OC::CORE::ticks when it was first seen waiting (see MidiInput)
+};
+
+// MIDI input dispatcher.
+//
+// The core ISR drains all pending usbMIDI messages into a ring of events once
+// per tick, just before the app ISR, so nothing else should call
+// usbMIDI.read(). Apps and applets each read the events they're interested in
+// through a MidiSubscriber, in the same tick.
+//
+// A SysEx message ends the drain for that tick, so that its data is still in
+// usbMIDI's buffer (usbMIDI.getSysExArray()) while the event is read. A
+// consumer that can't take any more SysEx calls Stall(), which leaves the next
+// tick's messages in the USB buffer, so that large dumps are throttled rather
+// than dropped.
+//
+// MIDI clock and transport messages also drive a PLL as they're drained, so
+// that followers get a smoothed tempo and pulse times rather than the ticks
+// that the pulses happened to be read in.
+//
+// Once a drain stops with messages possibly left in the USB buffer (at
+// OC_MIDI_INPUT_MAX_PER_TICK, after a SysEx, or stalled), the input is
+// backlogged until a drain empties the buffer. Events read while backlogged
+// are stamped with the tick the backlog began, the earliest they can have
+// been waiting, so that latency includes the time they spent in USB.
+class MidiInput {
+public:
+  static constexpr uint32_t kEvents = OC_MIDI_INPUT_EVENTS;
+  static_assert(!(kEvents & (kEvents - 1)), "MIDI input ring size must be pow2");
+
+  // Bit for each message type, for MidiSubscriber
+  static constexpr uint16_t type_mask(uint8_t type) {
+    return 1 << type;
+  }
+  static constexpr uint16_t kAllTypes = 0xffff;
+
+  void Init();
+  void Drain();
+
+  void Stall() {
+    stall_ = true;
+  }
+
+  // Drops the events that have arrived so far for all subscribers, e.g. when
+  // the app changes
+  void Flush() {
+    flushed_ = written_;
+  }
+
+  uint32_t written() const {
+    return written_;
+  }
+
+  const MidiEvent &event(uint32_t index) const {
+    return events_[index & (kEvents - 1)];
+  }
+
+  const util::ClockPll &clock() const {
+    return clock_;
+  }
+
+  // Stats for the debug menu: the most messages drained in one backlog,
+  // including those left in the USB buffer by the per-tick cap; the most ticks
+  // from an event being seen to its being read; and events a subscriber
+  // missed because it fell behind by more than the ring
+  uint32_t backlog_max() const {
+    return backlog_max_;
+  }
+
+  uint32_t latency_max() const {
+    return latency_max_;
+  }
+
+  uint32_t lost() const {
+    return lost_;
+  }
+
+  void ResetStats() {
+    backlog_max_ = latency_max_ = lost_ = 0;
+  }
+
+private:
+  friend class MidiSubscriber;
+
+  MidiEvent events_[kEvents];
+  volatile uint32_t written_;
+  uint32_t flushed_;
+  bool stall_;
+  util::ClockPll clock_;
+
+  bool backlogged_;
+  uint32_t backlog_since_; // Tick the backlog began
+  uint32_t backlog_; // Messages drained since then
+  uint32_t backlog_max_;
+  uint32_t latency_max_;
+  uint32_t lost_;
+
+  void Backlog(uint32_t tick) {
+    if (!backlogged_) {
+      backlogged_ = true;
+      backlog_since_ = tick;
+    }
+  }
+};
+
+extern MidiInput midi_input;
+
+// Reads the dispatcher's events of the given types, on the given channel (or
+// on any channel if 0). Messages that don't have a channel always pass.
+class MidiSubscriber {
+public:
+  MidiSubscriber(uint16_t types = MidiInput::kAllTypes, uint8_t channel = 0) {
+    Init(types, channel);
+  }
+
+  // Also skips the events that have already arrived
+  void Init(uint16_t types, uint8_t channel = 0) {
+    types_ = types;
+    channel_ = channel;
+    Skip();
+  }
+
+  void set_channel(uint8_t channel) {
+    channel_ = channel;
+  }
+
+  void Skip() {
+    read_ = midi_input.written();
+  }
+
+  bool Read(MidiEvent &event) {
+    const uint32_t written = midi_input.written();
+    if (static_cast<int32_t>(midi_input.flushed_ - read_) > 0) read_ = midi_input.flushed_;
+    if (written - read_ > MidiInput::kEvents) {
+      midi_input.lost_ += written - read_ - MidiInput::kEvents;
+      read_ = written - MidiInput::kEvents;
+    }
+    while (read_ != written) {
+      event = midi_input.event(read_++);
+      if (!(types_ & MidiInput::type_mask(event.type))) continue;
+      if (channel_ && event.channel && event.channel != channel_) continue;
+
+      const uint32_t latency = OC::CORE::ticks - event.tick;
+      if (latency > midi_input.latency_max_) midi_input.latency_max_ = latency;
+      return true;
+    }
+    return false;
+  }
+
+private:
+  uint32_t read_;
+  uint16_t types_;
+  uint8_t channel_;
+};
+
+}; // namespace OC
+
+#endif // OC_MIDI_INPUT_H_
@@ -23,6 +23,8 @@
 //#define INVERT_DISPLAY
 /* ------------ use DAC8564 -------------------------------------------------------------------------  */
 //#define DAC8564
+/* ------------ scan the CV inputs continuously by DMA, several samples per ISR (OC_ADC.h) ----------  */
+//#define ADC_DMA_SCAN
 
 #endif
 
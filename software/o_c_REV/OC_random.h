@@ -0,0 +1,38 @@
+#ifndef OC_RANDOM_H_
+#define OC_RANDOM_H_
+
+#include <stdint.h>
+#include "util/util_random.h"
+
+namespace OC {
+
+// Shared random number generator, and the seeds of generators that clients
+// (e.g. each Hemisphere applet) keep for themselves.
+//
+// It's seeded at boot from the time the splash screen took, unless a seed was
+// fixed before that (like the host build's --seed). With a fixed seed, every
+// client seed depends only on it and the client's id, so each client's
+// sequence repeats from run to run no matter what else drew numbers.
+class RandomSource : public util::Random {
+public:
+  void Init(uint32_t entropy) {
+    Seed(fixed_seed_ ? fixed_seed_ : Mix(entropy));
+  }
+
+  void set_fixed_seed(uint32_t seed) {
+    fixed_seed_ = seed;
+  }
+
+  uint32_t ClientSeed(uint32_t client) {
+    return fixed_seed_ ? Mix(fixed_seed_ ^ Mix(client)) : Next();
+  }
+
+private:
+  uint32_t fixed_seed_;
+};
+
+extern RandomSource random_source;
+
+}; // namespace OC
+
+#endif // OC_RANDOM_H_
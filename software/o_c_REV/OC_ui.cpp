@@ -6,6 +6,7 @@
 #include "OC_calibration.h"
 #include "OC_config.h"
 #include "OC_core.h"
+#include "OC_frame_pacing.h"
 #include "OC_gpio.h"
 #include "OC_menus.h"
 #include "OC_strings.h"
@@ -14,8 +15,6 @@
 #include "OC_options.h"
 #include "src/drivers/display.h"
 
-extern uint_fast8_t MENU_REDRAW;
-
 namespace OC {
 
 Ui ui;
@@ -129,7 +128,7 @@ UiMode Ui::DispatchEvents(App *app) {
       default:
         break;
     }
-    MENU_REDRAW = 1;
+    frame_pacing.RequestRedraw();
   }
 
   // Turning screensaver seconds into screen-blanking minutes with the * 60 (chysn 9/2/2018)
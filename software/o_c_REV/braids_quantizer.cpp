@@ -48,6 +48,29 @@ void Quantizer::Init() {
   for (int16_t i = 0; i < 128; ++i) {
     codebook_[i] = (i - 64) << 7;
   }
+  table_stale_ = true;
+}
+
+void QuantizerTable::Build(const int16_t *codebook) {
+  // Codewords 1 to 126 are the possible results. A pitch goes to the nearest
+  // one, or the lower one when it is exactly halfway.
+  for (int16_t q = 1; q < 126; ++q) {
+    edges_[q] = (codebook[q] + codebook[q + 1]) >> 1;
+  }
+  edges_[126] = 32767;
+
+  // Buckets from the last pitch of codeword 1 to the first pitch of 126
+  base_ = edges_[1];
+  int32_t span = edges_[125] + 1 - base_;
+  shift_ = 0;
+  while ((span >> shift_) >= static_cast<int32_t>(kSize)) ++shift_;
+
+  int16_t q = 1;
+  for (size_t i = 0; i < kSize; ++i) {
+    int32_t pitch = base_ + (static_cast<int32_t>(i) << shift_);
+    while (q < 126 && pitch > edges_[q]) ++q;
+    index_[i] = q;
+  }
 }
 
 int32_t Quantizer::Process(int32_t pitch, int32_t root, int32_t transpose) {
@@ -65,20 +88,28 @@ int32_t Quantizer::Process(int32_t pitch, int32_t root, int32_t transpose) {
     // We're still in the voronoi cell for the active codeword.
     pitch = codeword_;
   } else {
-    // Search for the nearest neighbour in the codebook.
-    int16_t upper_bound_index = std::upper_bound(
-        &codebook_[3],
-        &codebook_[126],
-        static_cast<int16_t>(pitch)) - &codebook_[0];
-    int16_t lower_bound_index = upper_bound_index - 2;
-
-    int16_t best_distance = 16384;
     int16_t q = -1;
-    for (int16_t i = lower_bound_index; i <= upper_bound_index; ++i) {
-      int16_t distance = abs(pitch - codebook_[i]);
-      if (distance < best_distance) {
-        best_distance = distance;
-        q = i;
+    if (table_) {
+      if (table_stale_) {
+        table_->Build(codebook_);
+        table_stale_ = false;
+      }
+      q = table_->Lookup(pitch);
+    } else {
+      // Search for the nearest neighbour in the codebook.
+      int16_t upper_bound_index = std::upper_bound(
+          &codebook_[3],
+          &codebook_[126],
+          static_cast<int16_t>(pitch)) - &codebook_[0];
+      int16_t lower_bound_index = upper_bound_index - 2;
+
+      int16_t best_distance = 16384;
+      for (int16_t i = lower_bound_index; i <= upper_bound_index; ++i) {
+        int16_t distance = abs(pitch - codebook_[i]);
+        if (distance < best_distance) {
+          best_distance = distance;
+          q = i;
+        }
       }
     }
 
@@ -36,15 +36,46 @@ namespace braids {
   
 struct Scale {
   int16_t span;
-  size_t num_notes;
+  uint32_t num_notes; // fixed width, this is persisted in GlobalSettings
   int16_t notes[16];
 };
 
 void SortScale(Scale &);
 
+// Direct-index table for the codeword search in Quantizer::Process. The pitch
+// range of the codebook is split into kSize buckets (a power of two wide, so
+// about 1/2 semitone for a chromatic scale), each holding the codeword index
+// for its lowest pitch. edges_[q] is the highest pitch that quantizes to q, so
+// a lookup is one table read plus, at most, a step or two across the edges in
+// the bucket. The result is the same as the search for any sorted codebook.
+//
+// The table is owned by the caller (e.g. the applet), so only the quantizers
+// that need it pay for the memory; see Quantizer::EnableTable.
+class QuantizerTable {
+ public:
+  static const size_t kSize = 256;
+
+  void Build(const int16_t *codebook);
+
+  inline int16_t Lookup(int32_t pitch) const {
+    int32_t bucket = (pitch - base_) >> shift_;
+    if (bucket < 0) bucket = 0;
+    else if (bucket > static_cast<int32_t>(kSize - 1)) bucket = kSize - 1;
+    int16_t q = index_[bucket];
+    while (q < 126 && pitch > edges_[q]) ++q;
+    return q;
+  }
+
+ private:
+  int32_t base_;
+  uint8_t shift_;
+  uint8_t index_[kSize];
+  int16_t edges_[127];
+};
+
 class Quantizer {
  public:
-  Quantizer() { }
+  Quantizer() : table_(NULL), table_stale_(false) { }
   ~Quantizer() { }
   
   void Init();
@@ -69,6 +100,16 @@ class Quantizer {
   // Force Process to process again
   void Requantize();
 
+  // Use a direct-index table instead of a binary search when the pitch leaves
+  // the current codeword's cell. For audio-rate or noisy CV. The table is
+  // rebuilt by the first Process after Init or Configure, so setting up a
+  // quantizer several times over (e.g. an applet's Start followed by its saved
+  // settings) only builds it once.
+  void EnableTable(QuantizerTable &table) {
+    table_ = &table;
+    table_stale_ = true;
+  }
+
  private:
   bool enabled_;
   int16_t enabled_notes_[16];
@@ -79,6 +120,8 @@ class Quantizer {
   int32_t next_boundary_;
   uint16_t note_number_;
   bool requantize_;
+  QuantizerTable *table_;
+  bool table_stale_;
 
   inline void Configure(const int16_t* notes, int16_t scale_span, size_t num_notes, uint16_t mask)
   {  
@@ -116,6 +159,7 @@ class Quantizer {
           ++octave;
         }
       }
+      table_stale_ = true;
     }
   }
 
@@ -33,11 +33,11 @@
 static inline int32_t signed_saturate_rshift(int32_t val, int bits, int rshift) __attribute__((always_inline, unused));
 static inline int32_t signed_saturate_rshift(int32_t val, int bits, int rshift)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("ssat %0, %1, %2, asr %3" : "=r" (out) : "I" (bits), "r" (val), "I" (rshift));
 	return out;
-#elif defined(KINETISL)
+#else // KINETISL, host
 	int32_t out, max;
 	out = val >> rshift;
 	max = 1 << (bits - 1);
@@ -54,14 +54,16 @@ static inline int32_t signed_saturate_rshift(int32_t val, int bits, int rshift)
 static inline int16_t saturate16(int32_t val) __attribute__((always_inline, unused));
 static inline int16_t saturate16(int32_t val)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int16_t out;
 	int32_t tmp;
 	asm volatile("ssat %0, %1, %2" : "=r" (tmp) : "I" (16), "r" (val) );
 	out = (int16_t) (tmp & 0xffff); // not sure if the & 0xffff is necessary. test.
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else // KINETISL, host
+	if (val > 32767) val = 32767;
+	else if (val < -32768) val = -32768;
+	return (int16_t)val;
 #endif
 }
 
@@ -69,11 +71,11 @@ static inline int16_t saturate16(int32_t val)
 static inline int32_t signed_multiply_32x16b(int32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t signed_multiply_32x16b(int32_t a, uint32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("smulwb %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
+#else // KINETISL, host
 	return ((int64_t)a * (int16_t)(b & 0xFFFF)) >> 16;
 #endif
 }
@@ -82,11 +84,11 @@ static inline int32_t signed_multiply_32x16b(int32_t a, uint32_t b)
 static inline int32_t signed_multiply_32x16t(int32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t signed_multiply_32x16t(int32_t a, uint32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("smulwt %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
+#else // KINETISL, host
 	return ((int64_t)a * (int16_t)(b >> 16)) >> 16;
 #endif
 }
@@ -95,12 +97,12 @@ static inline int32_t signed_multiply_32x16t(int32_t a, uint32_t b)
 static inline int32_t multiply_32x32_rshift32(int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_32x32_rshift32(int32_t a, int32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("smmul %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else // KINETISL, host
+	return ((int64_t)a * b) >> 32;
 #endif
 }
 
@@ -108,12 +110,12 @@ static inline int32_t multiply_32x32_rshift32(int32_t a, int32_t b)
 static inline uint32_t multiply_u32xu32_rshift32(uint32_t a, uint32_t b) __attribute__((always_inline));
 static inline uint32_t multiply_u32xu32_rshift32(uint32_t a, uint32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
   uint32_t out, tmp;
   asm volatile("umull %0, %1, %2, %3" : "=r" (tmp), "=r" (out) : "r" (a), "r" (b));
   return out;
-#elif defined(KINETISL)
-  return 0; // TODO....
+#else // KINETISL, host
+  return ((uint64_t)a * b) >> 32;
 #endif
 }
 
@@ -121,12 +123,12 @@ static inline uint32_t multiply_u32xu32_rshift32(uint32_t a, uint32_t b)
 static inline int32_t multiply_32x32_rshift32_rounded(int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_32x32_rshift32_rounded(int32_t a, int32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("smmulr %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else // KINETISL, host
+	return ((int64_t)a * b + 0x80000000) >> 32;
 #endif
 }
 
@@ -134,12 +136,12 @@ static inline int32_t multiply_32x32_rshift32_rounded(int32_t a, int32_t b)
 static inline int32_t multiply_accumulate_32x32_rshift32_rounded(int32_t sum, int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_accumulate_32x32_rshift32_rounded(int32_t sum, int32_t a, int32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("smmlar %0, %2, %3, %1" : "=r" (out) : "r" (sum), "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else // KINETISL, host
+	return sum + (int32_t)(((int64_t)a * b + 0x80000000) >> 32);
 #endif
 }
 
@@ -147,12 +149,12 @@ static inline int32_t multiply_accumulate_32x32_rshift32_rounded(int32_t sum, in
 static inline int32_t multiply_subtract_32x32_rshift32_rounded(int32_t sum, int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_subtract_32x32_rshift32_rounded(int32_t sum, int32_t a, int32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("smmlsr %0, %2, %3, %1" : "=r" (out) : "r" (sum), "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else // KINETISL, host
+	return sum - (int32_t)(((int64_t)a * b + 0x80000000) >> 32);
 #endif
 }
 
@@ -161,11 +163,11 @@ static inline int32_t multiply_subtract_32x32_rshift32_rounded(int32_t sum, int3
 static inline uint32_t pack_16t_16t(int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline uint32_t pack_16t_16t(int32_t a, int32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("pkhtb %0, %1, %2, asr #16" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
+#else // KINETISL, host
 	return (a & 0xFFFF0000) | ((uint32_t)b >> 16);
 #endif
 }
@@ -174,11 +176,11 @@ static inline uint32_t pack_16t_16t(int32_t a, int32_t b)
 static inline uint32_t pack_16t_16b(int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline uint32_t pack_16t_16b(int32_t a, int32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("pkhtb %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
+#else // KINETISL, host
 	return (a & 0xFFFF0000) | (b & 0x0000FFFF);
 #endif
 }
@@ -187,11 +189,11 @@ static inline uint32_t pack_16t_16b(int32_t a, int32_t b)
 static inline uint32_t pack_16b_16b(int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline uint32_t pack_16b_16b(int32_t a, int32_t b)
 {
-#if defined(KINETISK)
+#if defined(KINETISK) && defined(__arm__)
 	int32_t out;
 	asm volatile("pkhbt %0, %1, %2, lsl #16" : "=r" (out) : "r" (b), "r" (a));
 	return out;
-#elif defined(KINETISL)
+#else // KINETISL, host
 	return (a << 16) | (b & 0x0000FFFF);
 #endif
 }
@@ -13,6 +13,13 @@
 
 #define HEMISPHERE_AVAILABLE_APPLETS 51
 
+// Size of each hemisphere's slot in the applet arena, in bytes. This must hold the largest
+// applet (currently LoFiPCM).
+#define HEMISPHERE_APPLET_SLOT_SIZE 2200
+
+// Applets declared with DECLARE_DECIMATED_APPLET do their control-rate work once every n ticks
+// (power of 2). See HemisphereApplet::ControlTick().
+//
 //////////////////  id  cat   class name
 #define HEMISPHERE_APPLETS { \
     DECLARE_APPLET(  8, 0x01, ADSREG), \
@@ -33,12 +40,12 @@
     DECLARE_APPLET( 55, 0x80, DrCrusher), \
     DECLARE_APPLET(  9, 0x08, DualQuant), \
     DECLARE_APPLET( 45, 0x02, EnigmaJr), \
-    DECLARE_APPLET( 42, 0x11, EnvFollow), \
+    DECLARE_DECIMATED_APPLET( 42, 0x11, EnvFollow, 16), \
     DECLARE_APPLET( 29, 0x04, GateDelay), \
     DECLARE_APPLET( 17, 0x50, GatedVCA), \
     DECLARE_APPLET( 16, 0x80, LoFiPCM), \
     DECLARE_APPLET( 10, 0x44, Logic), \
-    DECLARE_APPLET( 21, 0x01, LowerRenz), \
+    DECLARE_DECIMATED_APPLET( 21, 0x01, LowerRenz, 16), \
     DECLARE_APPLET( 50, 0x04, Metronome), \
     DECLARE_APPLET(150, 0x20, hMIDIIn), \
     DECLARE_APPLET( 27, 0x20, hMIDIOut), \
@@ -57,7 +64,7 @@
     DECLARE_APPLET( 46, 0x08, Squanch), \
     DECLARE_APPLET(  3, 0x10, Switch), \
     DECLARE_APPLET( 13, 0x40, TLNeuron), \
-    DECLARE_APPLET( 37, 0x40, Trending), \
+    DECLARE_DECIMATED_APPLET( 37, 0x40, Trending, 16), \
     DECLARE_APPLET( 11, 0x06, TrigSeq), \
     DECLARE_APPLET( 25, 0x06, TrigSeq16), \
     DECLARE_APPLET( 39, 0x80, Tuner), \
@@ -33,7 +33,10 @@
 #include "OC_ADC.h"
 #include "OC_calibration.h"
 #include "OC_digital_inputs.h"
+#include "OC_frame_pacing.h"
 #include "OC_menus.h"
+#include "OC_midi_input.h"
+#include "OC_random.h"
 #include "OC_ui.h"
 #include "OC_version.h"
 #include "OC_options.h"
@@ -41,8 +44,8 @@
 #include "src/drivers/ADC/OC_util_ADC.h"
 #include "util/util_debugpins.h"
 
-unsigned long LAST_REDRAW_TIME = 0;
-uint_fast8_t MENU_REDRAW = true;
+OC::FramePacing OC::frame_pacing;
+OC::RandomSource OC::random_source;
 OC::UiMode ui_mode = OC::UI_MODE_MENU;
 const bool DUMMY = false;
 
@@ -69,9 +72,13 @@ void FASTRUN CORE_timer_ISR() {
   // a DMA transfer to the display things are fairly nicely interleaved. In the
   // next ISR, the display transfer is finalized (CS update).
 
+  OC::DEBUG::IsrTimeline timeline;
   display::Flush();
+  timeline.mark(OC::DEBUG::ISR_STAGE_DISPLAY_FLUSH);
   OC::DAC::Update();
+  timeline.mark(OC::DEBUG::ISR_STAGE_DAC);
   display::Update();
+  timeline.mark(OC::DEBUG::ISR_STAGE_DISPLAY_UPDATE);
 
   // The ADC scan uses async startSingleRead/readSingle and single channel each
   // loop, so should be fast enough even at 60us (check ADC::busy_waits() == 0)
@@ -79,11 +86,15 @@ void FASTRUN CORE_timer_ISR() {
   // 100us: 10kHz / 4 / 4 ~ .6kHz
   // 60us: 16.666K / 4 / 4 ~ 1kHz
   // kAdcSmoothing == 4 has some (maybe 1-2LSB) jitter but seems "Good Enough".
+  // With ADC_DMA_SCAN the conversions run continuously by DMA, and this only
+  // picks up the latest sample of each channel, so there's nothing to wait for.
   OC::ADC::Scan();
+  timeline.mark(OC::DEBUG::ISR_STAGE_ADC);
 
   // Pin changes are tracked in separate ISRs, so depending on prio it might
   // need extra precautions.
   OC::DigitalInputs::Scan();
+  timeline.mark(OC::DEBUG::ISR_STAGE_DIGITAL_INPUTS);
 
 #ifndef OC_UI_SEPARATE_ISR
   TODO needs a counter
@@ -91,8 +102,15 @@ void FASTRUN CORE_timer_ISR() {
 #endif
 
   ++OC::CORE::ticks;
-  if (OC::CORE::app_isr_enabled)
+  if (OC::CORE::app_isr_enabled) {
+    // Pending MIDI input is read for the app to pick up (see OC_midi_input.h)
+    OC::midi_input.Drain();
     OC::apps::ISR();
+  }
+  timeline.mark(OC::DEBUG::ISR_STAGE_APP);
+
+  // Stage histograms, and a trace entry if this ISR overran its period
+  OC::DEBUG::IsrDone(timeline, OC::CORE::ticks, OC::apps::current_app ? OC::apps::current_app->id : 0);
 
   OC_DEBUG_RESET_CYCLES(OC::CORE::ticks, 16384, OC::DEBUG::ISR_cycles);
 }
@@ -108,6 +126,7 @@ void setup() {
 
   OC::DEBUG::Init();
   OC::DigitalInputs::Init();
+  OC::midi_input.Init();
   delay(400); 
   OC::ADC::Init(&OC::calibration_data.adc); // Yes, it's using the calibration_data before it's loaded...
   OC::DAC::Init(&OC::calibration_data.dac);
@@ -145,6 +164,9 @@ void setup() {
   }
   OC::ui.set_screensaver_timeout(OC::calibration_data.screensaver_timeout);
 
+  // The splash screen took as long as the button was held, and the ADC's lowest bits are noise
+  OC::random_source.Init(ARM_DWT_CYCCNT ^ (OC::ADC::raw_value(ADC_CHANNEL_1) << 16) ^ OC::ADC::raw_value(ADC_CHANNEL_4));
+
   // initialize apps
   OC::apps::Init(reset_settings);
 }
@@ -154,6 +176,7 @@ void setup() {
 void FASTRUN loop() {
 
   OC::CORE::app_isr_enabled = true;
+  OC::frame_pacing.Init();
   uint32_t menu_redraws = 0;
   while (true) {
 
@@ -164,25 +187,29 @@ void FASTRUN loop() {
     }
 
     // Refresh display
-    if (MENU_REDRAW) {
+    if (OC::frame_pacing.frame_due()) {
+      debug::CycleMeasurement frame_cycles;
       GRAPHICS_BEGIN_FRAME(false); // Don't busy wait
         if (OC::UI_MODE_MENU == ui_mode) {
           OC_DEBUG_RESET_CYCLES(menu_redraws, 512, OC::DEBUG::MENU_draw_cycles);
           OC_DEBUG_PROFILE_SCOPE(OC::DEBUG::MENU_draw_cycles);
           OC::apps::current_app->DrawMenu();
+          OC::apps::DrawSaveProgress();
           ++menu_redraws;
         } else {
           //Blank the screen instead of drawing the screensaver (chysn 9/2/2018)
           //OC::apps::current_app->DrawScreensaver();
         }
-        MENU_REDRAW = 0;
-        LAST_REDRAW_TIME = millis();
       GRAPHICS_END_FRAME();
+      OC::frame_pacing.FrameDrawn(frame_cycles.read());
     }
 
     // Run current app
     OC::apps::current_app->loop();
 
+    // Write pending settings to EEPROM
+    OC::apps::SaveStep();
+
     // UI events
     OC::UiMode mode = OC::ui.DispatchEvents(OC::apps::current_app);
 
@@ -194,9 +221,6 @@ void FASTRUN loop() {
         OC::apps::current_app->HandleAppEvent(OC::APP_EVENT_SCREENSAVER_OFF);
       ui_mode = mode;
     }
-
-    if (millis() - LAST_REDRAW_TIME > REDRAW_TIMEOUT_MS)
-      MENU_REDRAW = 1;
   }
 }
 
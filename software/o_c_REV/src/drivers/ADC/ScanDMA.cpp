@@ -0,0 +1,39 @@
+#include "ScanDMA.h"
+#include <DMAChannel.h>
+
+static DMAChannel result_dma; // ADC0_RA -> ring, on each conversion
+static DMAChannel mux_dma;    // next SC1A -> ADC0_SC1A, after each result
+
+// SC1A values to write after each result, i.e. for the next pin in the list
+static uint32_t next_sc1a[ScanDMA::kMaxPins] __attribute__((aligned(ScanDMA::kMaxPins * sizeof(uint32_t))));
+static volatile uint16_t *scan_ring;
+
+/*static*/ void ScanDMA::Start(::ADC &adc, const uint8_t *pins, size_t num_pins, volatile uint16_t *ring, size_t ring_length) {
+  for (size_t i = 0; i < num_pins; ++i)
+    next_sc1a[i] = ::ADC::channel2sc1aADC0[pins[(i + 1) % num_pins]] & ADC_SC1A_CHANNELS;
+  scan_ring = ring;
+
+  result_dma.source(ADC0_RA);
+  result_dma.destinationCircular((uint16_t *)ring, ring_length * sizeof(uint16_t));
+  result_dma.transferSize(2);
+  result_dma.transferCount(1);
+  result_dma.triggerAtHardwareEvent(DMAMUX_SOURCE_ADC0);
+
+  mux_dma.sourceCircular(next_sc1a, num_pins * sizeof(uint32_t));
+  mux_dma.destination(ADC0_SC1A);
+  mux_dma.transferSize(4);
+  mux_dma.transferCount(1);
+  mux_dma.triggerAtCompletionOf(result_dma);
+
+  mux_dma.enable();
+  result_dma.enable();
+
+  // The first conversion also sets the mux (see ADC_Module::startReadFast),
+  // and from then on every completed conversion starts the next one
+  adc.enableDMA(ADC_0);
+  adc.startSingleRead(pins[0], ADC_0);
+}
+
+/*static*/ size_t ScanDMA::write_index() {
+  return (volatile uint16_t *)result_dma.TCD->DADDR - scan_ring;
+}
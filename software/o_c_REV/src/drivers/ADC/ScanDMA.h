@@ -0,0 +1,32 @@
+#ifndef SCAN_DMA_H_
+#define SCAN_DMA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "OC_util_ADC.h"
+
+// Free-running scan of a few ADC0 pins into an interleaved sample ring, with
+// no CPU involvement once started.
+//
+// Two linked DMA channels do the work: when a conversion completes, the ADC
+// DMA request moves ADC0_RA into the ring, and on completion that channel
+// triggers the second one, which writes the SC1A value of the next pin to
+// ADC0_SC1A and so starts the next conversion. The ring therefore fills as
+// fast as the ADC converts, independent of any ISR.
+//
+// Both the ring and the pin list use the DMA address modulo, so the number of
+// pins must be a power of two, and the ring a power-of-two number of samples
+// aligned to its size in bytes. All pins must use the same ADC mux (true for
+// the CV inputs on the Teensy 3.1/3.2).
+class ScanDMA {
+public:
+  static constexpr size_t kMaxPins = 4;
+
+  // Sample i of the ring is from pins[i % num_pins]
+  static void Start(::ADC &adc, const uint8_t *pins, size_t num_pins, volatile uint16_t *ring, size_t ring_length);
+
+  // Ring index of the next sample to be written
+  static size_t write_index();
+};
+
+#endif // SCAN_DMA_H_
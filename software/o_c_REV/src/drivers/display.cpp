@@ -27,7 +27,7 @@ weegfx::Graphics graphics;
 
 namespace display {
 
-FrameBuffer<SH1106_128x64_Driver::kFrameSize, 2> frame_buffer;
+FrameBuffer<SH1106_128x64_Driver::kFrameSize, 2, SH1106_128x64_Driver::kNumPages> frame_buffer;
 PagedDisplayDriver<SH1106_128x64_Driver> driver;
 
 void Init() {
@@ -38,6 +38,8 @@ void Init() {
 
 void AdjustOffset(uint8_t offset) {
 	SH1106_128x64_Driver::AdjustOffset(offset);
+	// The frame moves to other columns, so send all of it again
+	frame_buffer.Invalidate();
 }
 
 };
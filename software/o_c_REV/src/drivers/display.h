@@ -31,7 +31,7 @@
 
 namespace display {
 
-extern FrameBuffer<SH1106_128x64_Driver::kFrameSize, 2> frame_buffer;
+extern FrameBuffer<SH1106_128x64_Driver::kFrameSize, 2, SH1106_128x64_Driver::kNumPages> frame_buffer;
 extern PagedDisplayDriver<SH1106_128x64_Driver> driver;
 
 void Init();
@@ -48,8 +48,12 @@ static inline void Update() {
   if (driver.frame_valid()) {
     driver.Update();
   } else {
-    if (frame_buffer.readable())
-      driver.Begin(frame_buffer.readable_frame());
+    // Send the first changed page right away, instead of leaving the bus
+    // idle until the next ISR
+    if (frame_buffer.readable()) {
+      driver.Begin(frame_buffer.readable_frame(), frame_buffer.readable_pages());
+      driver.Update();
+    }
   }
 }
 
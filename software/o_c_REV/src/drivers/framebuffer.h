@@ -14,11 +14,22 @@
 // transferred.
 // See https://gist.github.com/patrickdowling/0029f58fb20e63d7db9d
 
-template <size_t frame_size, size_t frames>
+// Each written frame is also compared page-by-page against the previous one,
+// so the display driver only needs to send the pages that changed. Since
+// frames are never dropped, the previous frame is what the display will show
+// by the time this one is sent.
+
+template <size_t frame_size, size_t frames, size_t num_pages = 1>
 class FrameBuffer {
 public:
 
   static const size_t kFrameSize = frame_size;
+  static const size_t kNumPages = num_pages;
+  static const size_t kPageSize = frame_size / num_pages;
+  static const uint32_t kAllPages = (1ULL << num_pages) - 1;
+
+  static_assert(num_pages <= 32, "Page mask too small");
+  static_assert(!(kPageSize % sizeof(uint32_t)), "Page size must be multiple of 4");
 
   FrameBuffer() { }
 
@@ -27,6 +38,13 @@ public:
     for (size_t f = 0; f < frames; ++f)
       frame_buffers_[f] = frame_memory_ + kFrameSize * f;
     write_ptr_ = read_ptr_ = 0;
+    Invalidate();
+  }
+
+  // Mark all pages of the next written frame as changed, e.g. after the
+  // display was cleared or its contents are otherwise unknown
+  void Invalidate() {
+    invalidated_ = true;
   }
 
   size_t writeable() const {
@@ -42,6 +60,11 @@ public:
     return frame_buffers_[read_ptr_ % frames];
   }
 
+  // @return bit mask of the pages that differ from the previous frame
+  uint32_t readable_pages() const {
+    return frame_pages_[read_ptr_ % frames];
+  }
+
   // @return next writeable frame (assumes one exists)
   uint8_t *writeable_frame() {
     return frame_buffers_[write_ptr_ % frames];
@@ -52,13 +75,32 @@ public:
   }
 
   void written() {
+    const size_t index = write_ptr_ % frames;
+    frame_pages_[index] = invalidated_ ? kAllPages : changed_pages(frame_buffers_[index], frame_buffers_[(write_ptr_ - 1) % frames]);
+    invalidated_ = false;
     ++write_ptr_;
   }
 
 private:
 
+  static uint32_t changed_pages(const uint8_t *frame, const uint8_t *previous) {
+    const uint32_t *src = reinterpret_cast<const uint32_t *>(frame);
+    const uint32_t *prev = reinterpret_cast<const uint32_t *>(previous);
+    uint32_t pages = 0;
+    for (size_t p = 0; p < num_pages; ++p) {
+      uint32_t diff = 0;
+      for (size_t w = 0; w < kPageSize / sizeof(uint32_t); ++w)
+        diff |= *src++ ^ *prev++;
+      if (diff)
+        pages |= 1 << p;
+    }
+    return pages;
+  }
+
   uint8_t frame_memory_[kFrameSize * frames] __attribute__ ((aligned (4)));
   uint8_t *frame_buffers_[frames];
+  uint32_t frame_pages_[frames];
+  bool invalidated_;
 
   volatile size_t write_ptr_;
   volatile size_t read_ptr_;
@@ -7,6 +7,9 @@
 // In theory parts of the transfer may be done via DMA and the page memory
 // will have to be valid until that completes, so the ::Flush call is used
 // to determine if cleanup is necessary.
+//
+// Only the pages in the mask passed to ::Begin are sent (one per ::Update),
+// so a frame where little has changed completes in fewer updates.
 template <typename display_driver>
 class PagedDisplayDriver {
 public:
@@ -17,43 +20,56 @@ public:
 
     display_driver::Init();
 
-    current_page_index_ = 0;
-    current_page_data_ = NULL;
+    current_frame_ = NULL;
+    pending_pages_ = 0;
+    pages_sent_ = 0;
+    frames_sent_ = 0;
   }
 
-  void Begin(const uint8_t *frame) {
-    current_page_data_ = frame;
-    current_page_index_ = 0;
+  void Begin(const uint8_t *frame, uint32_t pages) {
+    current_frame_ = frame;
+    pending_pages_ = pages;
   }
 
   void Update() {
-    uint_fast8_t page = current_page_index_;
-    if (page < display_driver::kNumPages) {
-      const uint8_t *data = current_page_data_;
-      display_driver::SendPage(page, data);
-      current_page_index_ = page + 1;
-      current_page_data_ = data + display_driver::kPageSize;
+    uint32_t pages = pending_pages_;
+    if (pages) {
+      uint_fast8_t page = __builtin_ctz(pages);
+      display_driver::SendPage(page, current_frame_ + page * display_driver::kPageSize);
+      pending_pages_ = pages & (pages - 1);
+      ++pages_sent_;
     }
   }
 
   bool Flush() {
     display_driver::Flush();
-    if (current_page_index_ < display_driver::kNumPages) {
+    if (!current_frame_ || pending_pages_) {
       return false;
     } else {
-      current_page_index_ = 0;
-      current_page_data_ = NULL;
+      current_frame_ = NULL;
+      ++frames_sent_;
       return true;
     }
   }
 
   bool frame_valid() const {
-    return NULL != current_page_data_;
+    return NULL != current_frame_;
+  }
+
+  // Running totals, for stats
+  uint32_t pages_sent() const {
+    return pages_sent_;
+  }
+
+  uint32_t frames_sent() const {
+    return frames_sent_;
   }
 
 private:
-  uint_fast8_t current_page_index_;
-  const uint8_t *current_page_data_;
+  const uint8_t *current_frame_;
+  uint32_t pending_pages_;
+  uint32_t pages_sent_;
+  uint32_t frames_sent_;
 
   DISALLOW_COPY_AND_ASSIGN(PagedDisplayDriver);
 };
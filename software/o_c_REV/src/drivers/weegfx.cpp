@@ -45,11 +45,9 @@ const uint8_t test_bitmap[8] = {
 // - Bench templated draw_pixel_row (inlined versions) vs. function pointers
 // - Offer specialized functions w/o clipping or specific draw mode?
 // - Remainder masks as LUT or switch
-// - 32bit ops? Should be possible along x-axis (use SIMD instructions?) but not y (page stride)
 // - Clipping for x, y < 0
 // - Support 16 bit text characters?
 // - Kerning/BBX etc.
-// - print(string) -> print(char) can re-use variables
 // - etc.
 
 #define CLIPX(x, w) \
@@ -70,8 +68,41 @@ inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, uint8_t mask) __
 template <weegfx::DRAW_MODE draw_mode>
 inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, const uint8_t *src) __attribute__((always_inline));
 
+// Frame memory accessed a word at a time
+typedef uint32_t __attribute__((__may_alias__)) frame_word_t;
+
+// Rows of pixels with the same mask are filled a word at a time along x once
+// the destination is aligned; the frame itself is word-aligned, and so is the
+// start of every page. Short rows aren't worth the setup.
 template <weegfx::DRAW_MODE draw_mode>
 inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, uint8_t mask) {
+  if (draw_mode != weegfx::DRAW_DOT && count >= 8) {
+    while (reinterpret_cast<uintptr_t>(dst) & 0x3) {
+      switch (draw_mode) {
+        case weegfx::DRAW_NORMAL: *dst++ |= mask; break;
+        case weegfx::DRAW_INVERSE: *dst++ ^= mask; break;
+        case weegfx::DRAW_OVERWRITE: *dst++ = mask; break;
+        case weegfx::DRAW_CLEAR: *dst++ &= ~mask; break;
+        default: break;
+      }
+      --count;
+    }
+
+    const uint32_t mask32 = mask * 0x01010101U;
+    frame_word_t *dst32 = reinterpret_cast<frame_word_t *>(dst);
+    for (weegfx::coord_t words = count >> 2; words; --words) {
+      switch (draw_mode) {
+        case weegfx::DRAW_NORMAL: *dst32++ |= mask32; break;
+        case weegfx::DRAW_INVERSE: *dst32++ ^= mask32; break;
+        case weegfx::DRAW_OVERWRITE: *dst32++ = mask32; break;
+        case weegfx::DRAW_CLEAR: *dst32++ &= ~mask32; break;
+        default: break;
+      }
+    }
+    dst = reinterpret_cast<uint8_t *>(dst32);
+    count &= 0x3;
+  }
+
   while (count-- > 0x0) {
     switch (draw_mode) {
       case weegfx::DRAW_NORMAL: *dst++ |= mask; break;
@@ -144,10 +175,13 @@ inline void draw_rect(uint8_t *buf, weegfx::coord_t y, weegfx::coord_t w, weegfx
     buf += Graphics::kWidth;
   }
 
+  // Whole pages can be overwritten, except when inverting
+  static constexpr weegfx::DRAW_MODE page_mode = draw_mode == weegfx::DRAW_INVERSE ? draw_mode : weegfx::DRAW_OVERWRITE;
+  const uint8_t page_mask = draw_mode == weegfx::DRAW_CLEAR ? 0x00 : 0xff;
   remainder = h & 0x7;
   h >>= 3;
   while (h--) {
-    draw_pixel_row<draw_mode>(buf, w, 0xff);
+    draw_pixel_row<page_mode>(buf, w, page_mask);
     buf += Graphics::kWidth;
   }
 
@@ -395,40 +429,132 @@ static inline weegfx::font_glyph get_char_glyph(char c) {
   return ssd1306xled_font6x8 + Graphics::kFixedFontW * (c - 32);
 }
 
-// OPTIMIZE When printing strings, all chars will have the same y/remainder
-// This will probably only save a few cycles, if any. Also the clipping can
-// be made optional (template?)
-void Graphics::draw_char(char c, coord_t x, coord_t y) {
-  if (!c) c = '0';
-  if (c <= 32 || c > 127)
-    return;
+// Glyph blitter
+// The font is one page high, so each glyph column is a single byte that is
+// either written whole into one page (text on a page boundary) or shifted
+// across two. The pages and shift are the same for every glyph of a string,
+// so they are worked out once; the rows are NULL if they're off-screen.
+struct GlyphRows {
+  uint8_t *top;
+  uint8_t *bottom;
+  unsigned shift;
+
+  GlyphRows(uint8_t *frame, weegfx::coord_t y) {
+    shift = y & 0x7;
+    const weegfx::coord_t page = y >> 3; // -1 if y < 0
+    top = page >= 0 && page < Graphics::kHeight / 8 ? frame + (page << 7) : NULL;
+    bottom = shift && page + 1 >= 0 && page + 1 < Graphics::kHeight / 8 ? frame + ((page + 1) << 7) : NULL;
+  }
 
-  coord_t w = Graphics::kFixedFontW;
-  coord_t h = Graphics::kFixedFontH;
-  font_glyph data = get_char_glyph(c);
-  if (c + w > kWidth) w = kWidth - x;
-  if (x < 0) {
-    w += x;
-    data += x;
+  bool visible() const {
+    return top || bottom;
   }
-  if (w <= 0) return;
-  CLIPY(y, h);
+};
 
-  uint8_t *dest = get_frame_ptr(x, y);
-  coord_t remainder = y & 0x7;
-  if (!remainder) {
-    SETPIXELS_H(dest, w, *data++);
+static inline bool glyph_drawable(char c) __attribute__((always_inline));
+static inline bool glyph_drawable(char c) {
+  return c > 32 && c <= 127;
+}
+
+// A glyph that is entirely on-screen is ORed into each page as a word and a
+// halfword; the Cortex-M4 handles the unaligned accesses. Off a page
+// boundary, all six columns are shifted at once, with masks that keep the
+// bits from crossing into the neighbouring column.
+static inline void or_glyph_columns(uint8_t *dst, uint32_t columns32, uint16_t columns16) __attribute__((always_inline));
+static inline void or_glyph_columns(uint8_t *dst, uint32_t columns32, uint16_t columns16) {
+  uint32_t dst32;
+  uint16_t dst16;
+  memcpy(&dst32, dst, 4);
+  memcpy(&dst16, dst + 4, 2);
+  dst32 |= columns32;
+  dst16 |= columns16;
+  memcpy(dst, &dst32, 4);
+  memcpy(dst + 4, &dst16, 2);
+}
+
+template <bool aligned>
+static inline void blit_glyph(const GlyphRows &rows, char c, weegfx::coord_t x) __attribute__((always_inline));
+
+template <bool aligned>
+static inline void blit_glyph(const GlyphRows &rows, char c, weegfx::coord_t x) {
+  const weegfx::coord_t kW = Graphics::kFixedFontW;
+  weegfx::font_glyph glyph = get_char_glyph(c);
+
+  if (x >= 0 && x <= Graphics::kWidth - kW) {
+    uint32_t glyph32;
+    uint16_t glyph16;
+    memcpy(&glyph32, glyph, 4);
+    memcpy(&glyph16, glyph + 4, 2);
+    if (aligned) {
+      or_glyph_columns(rows.top + x, glyph32, glyph16);
+    } else {
+      const unsigned shift = rows.shift;
+      if (rows.top) {
+        const uint32_t mask = 0x01010101U * ((0xff << shift) & 0xff);
+        or_glyph_columns(rows.top + x, (glyph32 << shift) & mask, (glyph16 << shift) & mask);
+      }
+      if (rows.bottom) {
+        const uint32_t mask = 0x01010101U * (0xff >> (8 - shift));
+        or_glyph_columns(rows.bottom + x, (glyph32 >> (8 - shift)) & mask, (glyph16 >> (8 - shift)) & mask);
+      }
+    }
+    return;
+  }
+
+  weegfx::coord_t start = 0, end = kW;
+  if (x < 0) start = -x;
+  if (x + kW > Graphics::kWidth) end = Graphics::kWidth - x;
+
+  if (aligned) {
+    uint8_t *dst = rows.top + x;
+    for (weegfx::coord_t i = start; i < end; ++i)
+      dst[i] |= glyph[i];
   } else {
-    const uint8_t *src = data;
-    SETPIXELS_H(dest, w, (*src++) << remainder);
-    if (h >= 8) {
-      dest += kWidth;
-      src = data;
-      SETPIXELS_H(dest, w, (*src++) >> (8 - remainder));
+    const unsigned shift = rows.shift;
+    uint8_t *top = rows.top;
+    uint8_t *bottom = rows.bottom;
+    for (weegfx::coord_t i = start; i < end; ++i) {
+      const uint_fast16_t column = glyph[i] << shift;
+      if (top) top[x + i] |= column;
+      if (bottom) bottom[x + i] |= column >> 8;
     }
   }
 }
 
+template <bool aligned>
+static void blit_string(const GlyphRows &rows, const char *s, weegfx::coord_t x) {
+  char c;
+  while ((c = *s++) && x < Graphics::kWidth) {
+    if (glyph_drawable(c) && x > -Graphics::kFixedFontW)
+      blit_glyph<aligned>(rows, c, x);
+    x += Graphics::kFixedFontW;
+  }
+}
+
+void Graphics::draw_char(char c, coord_t x, coord_t y) {
+  if (!c) c = '0';
+  if (!glyph_drawable(c))
+    return;
+
+  GlyphRows rows(frame_, y);
+  if (!rows.visible() || x <= -kFixedFontW || x >= kWidth)
+    return;
+  if (rows.shift)
+    blit_glyph<false>(rows, c, x);
+  else
+    blit_glyph<true>(rows, c, x);
+}
+
+void Graphics::draw_string(const char *s, coord_t x, coord_t y) {
+  GlyphRows rows(frame_, y);
+  if (!rows.visible())
+    return;
+  if (rows.shift)
+    blit_string<false>(rows, s, x);
+  else
+    blit_string<true>(rows, s, x);
+}
+
 void Graphics::print(char c) {
   draw_char(c, text_x_, text_y_);
   text_x_ += kFixedFontW;
@@ -495,7 +621,7 @@ void Graphics::print(uint16_t value, unsigned width) {
   print(str);
 }
 
-void Graphics::print(uint32_t value, size_t width) {
+void Graphics::print(uint32_t value, unsigned width) {
   char buf[24];
   char *str = itos<uint32_t, false>(value, buf, sizeof(buf));
   while (str > buf &&
@@ -540,28 +666,12 @@ void Graphics::pretty_print_right(int value) {
 }
 
 void Graphics::print(const char *s) {
-  coord_t x = text_x_;
-  coord_t y = text_y_;
-
-  // TODO Track position, only clip when necessary or early-out?
-  while (*s) {
-    draw_char(*s++, x, y);
-    x += kFixedFontW;
-  }
-
-  text_x_ = x;
+  draw_string(s, text_x_, text_y_);
+  text_x_ += static_cast<coord_t>(strlen(s)) * kFixedFontW;
 }
 
 void Graphics::print_right(const char *s) {
-  weegfx::coord_t x = text_x_;
-  weegfx::coord_t y = text_y_;
-  const char *c = s;
-  while (*c) ++c; // find end
-
-  while (c > s) {
-    x -= kFixedFontW;
-    draw_char(*--c, x, y);
-  }
+  draw_string(s, text_x_ - static_cast<coord_t>(strlen(s)) * kFixedFontW, text_y_);
 }
 
 void Graphics::printf(const char *fmt, ...) {
@@ -574,8 +684,5 @@ void Graphics::printf(const char *fmt, ...) {
 }
 
 void Graphics::drawStr(coord_t x, coord_t y, const char *s) {
-  while (*s) {
-    draw_char(*s++, x, y);
-    x += kFixedFontW;
-  }
+  draw_string(s, x, y);
 }
@@ -0,0 +1,114 @@
+#ifndef UTIL_CLOCK_PHASE_H_
+#define UTIL_CLOCK_PHASE_H_
+
+#include <stdint.h>
+
+namespace util {
+
+// Tempo clock as a phase accumulator, advanced once per tick.
+//
+// A tock is 100 * ticks_per_minute units of phase, so that the increment per
+// tick is exactly the tempo in 1/100 BPM times the multiplier. There's no
+// rounding to accumulate, so the clock doesn't drift against the ideal tempo
+// however long it runs, and the tick path is an add and two compares. A
+// period of two tocks lets swing delay every second tock, up to 3/4 of the way
+// through the pair.
+template <uint32_t ticks_per_minute>
+class ClockPhase {
+public:
+  static constexpr uint32_t kTockPhase = 100 * ticks_per_minute;
+  static constexpr uint32_t kPairPhase = 2 * kTockPhase;
+  static constexpr uint8_t kSwingMin = 50;
+  static constexpr uint8_t kSwingMax = 75;
+  static_assert(ticks_per_minute <= 20000000, "Phase of two tocks overflows the accumulator");
+
+  void Init() {
+    phase_ = 0;
+    increment_ = 0;
+    SetSwing(kSwingMin);
+    Reset();
+  }
+
+  // Tempo in 1/100 BPM, tocks per beat
+  void SetRate(uint32_t hundredths_bpm, uint32_t multiply) {
+    increment_ = hundredths_bpm * multiply;
+  }
+
+  // Units of phase per tick, for a clock that follows another one
+  void SetIncrement(uint32_t increment) {
+    increment_ = increment;
+  }
+
+  // Percent of a pair of tocks before the second one, 50 for straight time
+  void SetSwing(uint8_t percent) {
+    if (percent < kSwingMin) percent = kSwingMin;
+    if (percent > kSwingMax) percent = kSwingMax;
+    swing_phase_ = (kPairPhase / 100) * percent;
+  }
+
+  // The next Advance() is the first tock of a pair
+  void Reset() {
+    phase_ = kPairPhase;
+    second_ = true;
+  }
+
+  // Moves to phase within the pair, e.g. to join another clock. A tock at
+  // exactly that phase falls in the next Advance().
+  void Sync(uint32_t phase) {
+    if (!phase) {
+      Reset();
+    } else {
+      phase_ = phase;
+      second_ = phase > swing_phase_;
+    }
+  }
+
+  // Within the pair of tocks, [0, kPairPhase]
+  uint32_t phase() const {
+    return phase_;
+  }
+
+  // @return true if a tock falls in this tick. The phase is that of the start
+  // of the tick when it's checked, so a tock is in the first tick at or after
+  // its ideal time.
+  bool Advance() {
+    bool tock = false;
+    if (phase_ >= kPairPhase) {
+      phase_ -= kPairPhase;
+      second_ = false;
+      tock = true;
+    } else if (!second_ && phase_ >= swing_phase_) {
+      second_ = true;
+      tock = true;
+    }
+    phase_ += increment_;
+    return tock;
+  }
+
+  // Advances by a number of ticks, of which all but the last were missed, e.g.
+  // while the ISR was held off. The phase ends up where it would have been, and
+  // any tocks that fell in the missed ticks come out as one, late, in the last.
+  bool Advance(uint32_t ticks) {
+    if (ticks > 1) {
+      const uint64_t phase = phase_ + static_cast<uint64_t>(increment_) * (ticks - 1);
+      if (phase >= kPairPhase) {
+        phase_ = phase % kPairPhase;
+        second_ = phase_ >= swing_phase_;
+        phase_ += increment_;
+        return true;
+      }
+      phase_ = phase;
+    }
+    return Advance();
+  }
+
+private:
+  uint32_t phase_;
+  uint32_t increment_;
+  uint32_t swing_phase_;
+  bool second_;
+};
+
+}; // namespace util
+
+#endif // UTIL_CLOCK_PHASE_H_
@@ -0,0 +1,166 @@
+#ifndef UTIL_CLOCK_PLL_H_
+#define UTIL_CLOCK_PLL_H_
+
+#include <stdint.h>
+
+namespace util {
+
+// Phase-locked loop for an external pulse clock that arrives with jitter, e.g.
+// 24 ppqn MIDI clock read from USB once per tick.
+//
+// Each pulse's arrival tick is compared with the time the loop predicted for
+// it. A share of the error moves the loop's estimate of where the pulse really
+// was, and a smaller share corrects the period, so that the estimates follow
+// the sender's tempo while averaging out the jitter. The gains are higher
+// until the loop has locked, which takes about a beat of pulses; both sets are
+// critically damped. Times are in ticks with kShift fractional bits, and the
+// arithmetic is all shifts, once per pulse.
+class ClockPll {
+public:
+  static constexpr int kShift = 16;
+  static constexpr uint32_t kLockPulses = 24;
+
+  // Pulses further apart than max_period ticks restart the loop, and the
+  // period stays within the range
+  void Init(uint32_t min_period, uint32_t max_period) {
+    min_period_ = min_period << kShift;
+    max_period_ = max_period << kShift;
+    period_ = max_period_;
+    offset_ = 0;
+    last_tick_ = 0;
+    sequence_ = index_ = 0;
+    jitter_ = 0;
+    good_pulses_ = 0;
+    state_ = STATE_IDLE;
+    locked_ = stopped_ = restart_ = false;
+  }
+
+  // Transport messages. The pulse after Start() is pulse 0, and its tick
+  // re-anchors the phase, but the period carries over.
+  void Start() {
+    stopped_ = false;
+    restart_ = true;
+  }
+
+  void Continue() {
+    stopped_ = false;
+  }
+
+  void Stop() {
+    stopped_ = true;
+  }
+
+  void Pulse(uint32_t tick) {
+    const uint32_t elapsed = tick - last_tick_;
+    last_tick_ = tick;
+    ++sequence_;
+    ++index_;
+    if (restart_) {
+      restart_ = false;
+      index_ = 0;
+      if (state_ == STATE_TRACKING) {
+        offset_ = 0;
+        return;
+      }
+    }
+
+    if (state_ == STATE_IDLE || elapsed > (max_period_ >> kShift)) {
+      state_ = STATE_FIRST;
+      locked_ = false;
+      return;
+    }
+    if (state_ == STATE_FIRST) {
+      if (elapsed < (min_period_ >> kShift)) return;
+      period_ = elapsed << kShift;
+      offset_ = 0;
+      good_pulses_ = 0;
+      state_ = STATE_TRACKING;
+      return;
+    }
+
+    // Predicted from the previous pulse's estimated time
+    const int32_t error = static_cast<int32_t>(elapsed << kShift) - offset_ - static_cast<int32_t>(period_);
+    const uint32_t magnitude = error < 0 ? -error : error;
+    const int phase_shift = locked_ ? 2 : 1;
+    const int period_shift = locked_ ? 6 : 4;
+
+    offset_ = -(error - (error >> phase_shift));
+    int32_t period = static_cast<int32_t>(period_) + (error >> period_shift);
+    if (period < static_cast<int32_t>(min_period_)) period = min_period_;
+    if (period > static_cast<int32_t>(max_period_)) period = max_period_;
+    period_ = period;
+
+    jitter_ += (static_cast<int32_t>(magnitude) - static_cast<int32_t>(jitter_)) >> 4;
+    if (magnitude < period_ >> 2) {
+      if (++good_pulses_ >= kLockPulses) locked_ = true;
+    } else {
+      good_pulses_ = 0;
+      if (magnitude > period_ >> 1) locked_ = false;
+    }
+  }
+
+  // Following the pulses at tick, unless they've stopped or there's been no
+  // pulse for more than 4 periods
+  bool running(uint32_t tick) const {
+    return state_ == STATE_TRACKING && !stopped_ && !timed_out(tick);
+  }
+
+  bool locked(uint32_t tick) const {
+    return locked_ && state_ == STATE_TRACKING && !timed_out(tick);
+  }
+
+  // Pulses so far, to tell when there's a new one
+  uint32_t sequence() const {
+    return sequence_;
+  }
+
+  // Of the latest pulse, since Start()
+  uint32_t index() const {
+    return index_;
+  }
+
+  // Estimated ticks per pulse
+  uint32_t period() const {
+    return period_;
+  }
+
+  // Estimated time of the latest pulse, relative to the tick it arrived in
+  int32_t offset() const {
+    return offset_;
+  }
+
+  // Average difference between the predicted and actual pulse times, in ticks
+  // with kShift fractional bits
+  uint32_t jitter() const {
+    return jitter_;
+  }
+
+private:
+  enum State {
+    STATE_IDLE,
+    STATE_FIRST,
+    STATE_TRACKING
+  };
+
+  uint32_t min_period_;
+  uint32_t max_period_;
+  uint32_t period_;
+  int32_t offset_;
+  uint32_t last_tick_;
+  uint32_t sequence_;
+  uint32_t index_;
+  uint32_t jitter_;
+  uint32_t good_pulses_;
+  State state_;
+  bool locked_;
+  bool stopped_;
+  bool restart_;
+
+  bool timed_out(uint32_t tick) const {
+    return tick - last_tick_ > (period_ >> (kShift - 2));
+  }
+};
+
+}; // namespace util
+
+#endif // UTIL_CLOCK_PLL_H_
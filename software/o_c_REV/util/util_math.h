@@ -38,6 +38,7 @@
 #define MOD_8(n, div) \
   FAST_FP_MOD(n, div, 8)
 
+#ifdef __arm__
 inline uint32_t USAT16(uint32_t value) __attribute__((always_inline));
 inline uint32_t USAT16(uint32_t value) {
   uint32_t result;
@@ -68,6 +69,32 @@ static inline uint32_t multiply_u32xu32_rshift(uint32_t a, uint32_t b, uint32_t
   return (lo >> shift) | (hi << (32 - shift));
 }
 
+#else // Host build: portable equivalents
+
+inline uint32_t USAT16(uint32_t value) __attribute__((always_inline));
+inline uint32_t USAT16(uint32_t value) {
+  return (int32_t)value < 0 ? 0 : (value > 65535 ? 65535 : value);
+}
+
+inline uint32_t USAT16(int32_t value) __attribute__((always_inline));
+inline uint32_t USAT16(int32_t value) {
+  return value < 0 ? 0 : (value > 65535 ? 65535 : value);
+}
+
+static inline uint32_t multiply_u32xu32_rshift24(uint32_t a, uint32_t b) __attribute__((always_inline));
+static inline uint32_t multiply_u32xu32_rshift24(uint32_t a, uint32_t b)
+{
+  return ((uint64_t)a * b) >> 24;
+}
+
+static inline uint32_t multiply_u32xu32_rshift(uint32_t a, uint32_t b, uint32_t shift) __attribute__((always_inline));
+static inline uint32_t multiply_u32xu32_rshift(uint32_t a, uint32_t b, uint32_t shift)
+{
+  return ((uint64_t)a * b) >> shift;
+}
+
+#endif // __arm__
+
 template <typename T, T smoothing>
 struct SmoothedValue {
   SmoothedValue() : value_(0) { }
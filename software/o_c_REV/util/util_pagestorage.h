@@ -56,8 +56,14 @@ enum EStorageMode {
  * an UPDATE method that furthere minimizes actual writes, but may be slower.
  *
  * The optional FASTSCAN parameter to can be used for force a scan of all pages
- * during ::load. If it is true, the scan stops at the first non-good page,
- * which is faster but might miss pages if a write is corrupted.
+ * during ::load. If it is true, ::load only reads the page headers it needs to
+ * find the newest page, which is faster but might miss pages if a write is
+ * corrupted.
+ *
+ * Writing a page can take a long time (EEPROM writes are in the order of ms),
+ * so it can also be done incrementally: ::BeginSave takes a copy of the data
+ * and ::SaveStep then writes a limited number of bytes each call until the
+ * page is complete. ::Save does both in one go.
  */
 template <typename STORAGE, size_t BASE_ADDR, size_t END_ADDR, typename DATA_TYPE, EStorageMode MODE = STORAGE_UPDATE, bool FASTSCAN=true>
 class PageStorage {
@@ -102,12 +108,13 @@ public:
    */
   void Init() {
     page_index_ = -1;
+    save_remaining_ = 0;
     page_.header.fourcc = DATA_TYPE::FOURCC;
     page_.header.size = sizeof(DATA_TYPE);
   }
 
   /**
-   * Scan all pages to find the newest to load.
+   * Find the newest page to load.
    * If no data found, initialize internal page to empty.
    * @param data [out] loaded data if load successful, else unmodified
    * @return true if data loaded
@@ -115,35 +122,15 @@ public:
   bool Load(DATA_TYPE &data) {
 
     page_index_ = -1;
-    memset(&page_, 0, sizeof(page_));
-    page_.header.generation = -1;
-    page_data next_page;
-    for (size_t i = 0; i < PAGES; ++i) {
-      STORAGE::read(BASE_ADDR + i * PAGESIZE, &next_page, sizeof(next_page));
+    save_remaining_ = 0;
+    if (FASTSCAN)
+      ProbePages();
+    else
+      ScanPages();
 
-      STORAGE_PRINTF("[%u]\n", BASE_ADDR + i * PAGESIZE);
-      STORAGE_PRINTF("FOURCC:%x (%x)\n", next_page.header.fourcc, DATA_TYPE::FOURCC);
-      STORAGE_PRINTF("size  :%u (%u)\n", next_page.header.size, sizeof(DATA_TYPE));
-      STORAGE_PRINTF("gen   :%u (%u)\n", next_page.header.generation, page_.header.generation);
-
-      if ((DATA_TYPE::FOURCC != next_page.header.fourcc) ||
-          (sizeof(DATA_TYPE) != next_page.header.size) ||
-          (next_page.header.checksum != checksum(next_page)) ||
-          (next_page.header.generation < page_.header.generation && (int32_t)page_.header.generation != -1)) {
-        if (FASTSCAN) {
-          STORAGE_PRINTF("Aborting scan at page %d\n", i);
-          break;
-        } else {
-          STORAGE_PRINTF("Ignoring page %d\n", i);
-          continue;
-        }
-      }
-
-      page_index_ = i;
-      memcpy(&page_, &next_page, sizeof(page_));
-    }
-    
     if (-1 == page_index_) {
+      memset(&page_, 0, sizeof(page_));
+      page_.header.generation = -1;
       page_.header.fourcc = DATA_TYPE::FOURCC;
       page_.header.size = sizeof(DATA_TYPE);
       return false;
@@ -159,6 +146,20 @@ public:
    * @return true if data was written to storage
    */
   bool Save(const DATA_TYPE &data) {
+    if (!BeginSave(data))
+      return false;
+    while (SaveStep(PAGESIZE)) { }
+    return true;
+  }
+
+  /**
+   * Start saving data to storage without writing anything yet; assumes ::load
+   * has been called! The data is copied, so it can change while the save is
+   * pending. Saving again while pending restarts the save of the same page.
+   * @param data data to be stored
+   * @return true if data has to be written, i.e. ::SaveStep is needed
+   */
+  bool BeginSave(const DATA_TYPE &data) {
 
     bool dirty = false;
     const uint8_t *src = (const uint8_t*)&data;
@@ -174,24 +175,140 @@ public:
     }
 
     if (dirty) {
-      ++page_.header.generation;
+      if (!save_remaining_) {
+        ++page_.header.generation;
+        page_index_ = (page_index_ + 1) % PAGES;
+      }
       page_.header.checksum = checksum(page_);
-      page_index_ = (page_index_ + 1) % PAGES;
+      save_remaining_ = PAGESIZE;
+    }
+
+    return save_remaining_;
+  }
 
-      if (STORAGE_UPDATE == MODE)
-        STORAGE::update(BASE_ADDR + page_index_ * PAGESIZE, &page_, sizeof(page_));
-      else
-        STORAGE::write(BASE_ADDR + page_index_ * PAGESIZE, &page_, sizeof(page_));
+  /**
+   * Write (part of) a pending save. The page data is written before the
+   * header, so the page doesn't validate until it's complete. In UPDATE mode,
+   * bytes that are already in storage are only read.
+   * @param max_writes maximum number of bytes to write
+   * @return true if the save is still pending
+   */
+  bool SaveStep(size_t max_writes) {
+    const uint8_t *src = (const uint8_t *)&page_;
+    const size_t addr = page_addr(page_index_);
+    while (save_remaining_ && max_writes) {
+      const size_t offset = (PAGESIZE - save_remaining_ + sizeof(page_header)) % PAGESIZE;
+      --save_remaining_;
+      if (STORAGE_UPDATE == MODE) {
+        uint8_t value;
+        STORAGE::read(addr + offset, &value, 1);
+        if (value == src[offset])
+          continue;
+      }
+      STORAGE::write(addr + offset, src + offset, 1);
+      --max_writes;
     }
+    return save_remaining_;
+  }
 
-    return dirty;
+  /**
+   * @return number of bytes of the page not yet written by ::SaveStep; 0 if
+   * no save is pending
+   */
+  size_t save_remaining() const {
+    return save_remaining_;
   }
 
 protected:
 
   int page_index_;
+  size_t save_remaining_;
   page_data page_;
 
+  size_t page_addr(size_t i) const {
+    return BASE_ADDR + i * PAGESIZE;
+  }
+
+  static bool valid_header(const page_header &header) {
+    return DATA_TYPE::FOURCC == header.fourcc && sizeof(DATA_TYPE) == header.size;
+  }
+
+  bool read_header(size_t i, page_header &header) const {
+    STORAGE::read(page_addr(i), &header, sizeof(header));
+    return valid_header(header);
+  }
+
+  /**
+   * Pages are written in order, each with the next generation, so from the
+   * first page up to the newest they have consecutive generations and the
+   * rest (if any) are older. The end of that run is found by a binary search
+   * over the headers; only the newest page is then read in full. If that
+   * fails the checksum, the pages before it are tried in turn.
+   */
+  void ProbePages() {
+    page_header header;
+    if (!read_header(0, header)) {
+      STORAGE_PRINTF("Aborting scan at page 0\n");
+      return;
+    }
+
+    const uint32_t first_generation = header.generation;
+    size_t newest = 0;
+    size_t end = PAGES;
+    while (end - newest > 1) {
+      const size_t i = (newest + end) / 2;
+      page_header next_header;
+      if (read_header(i, next_header) && next_header.generation == first_generation + i) {
+        newest = i;
+        header = next_header;
+      } else {
+        end = i;
+      }
+    }
+
+    STORAGE_PRINTF("Newest page %u, gen %u\n", newest, header.generation);
+    const uint32_t generation = header.generation;
+    for (size_t n = 0; n < PAGES; ++n) {
+      const size_t i = (newest + PAGES - n) % PAGES;
+      if (n && (!read_header(i, header) || header.generation != generation - n))
+        break;
+      page_.header = header;
+      STORAGE::read(page_addr(i) + sizeof(page_header),
+                    (uint8_t *)&page_ + sizeof(page_header),
+                    sizeof(page_) - sizeof(page_header));
+      if (page_.header.checksum == checksum(page_)) {
+        page_index_ = i;
+        break;
+      }
+      STORAGE_PRINTF("Bad checksum in page %u\n", i);
+    }
+  }
+
+  void ScanPages() {
+    memset(&page_, 0, sizeof(page_));
+    page_.header.generation = -1;
+    page_data next_page;
+    for (size_t i = 0; i < PAGES; ++i) {
+      STORAGE::read(page_addr(i), &next_page, sizeof(next_page));
+
+      STORAGE_PRINTF("[%u]\n", page_addr(i));
+      STORAGE_PRINTF("FOURCC:%x (%x)\n", next_page.header.fourcc, DATA_TYPE::FOURCC);
+      STORAGE_PRINTF("size  :%u (%u)\n", next_page.header.size, sizeof(DATA_TYPE));
+      STORAGE_PRINTF("gen   :%u (%u)\n", next_page.header.generation, page_.header.generation);
+
+      if ((DATA_TYPE::FOURCC != next_page.header.fourcc) ||
+          (sizeof(DATA_TYPE) != next_page.header.size) ||
+          (next_page.header.checksum != checksum(next_page)) ||
+          (next_page.header.generation < page_.header.generation && (int32_t)page_.header.generation != -1)) {
+        STORAGE_PRINTF("Ignoring page %d\n", i);
+        continue;
+      }
+
+      page_index_ = i;
+      memcpy(&page_, &next_page, sizeof(page_));
+    }
+  }
+
   static uint16_t checksum(const page_data &page) {
     uint16_t c = 0;
     // header not included in crc
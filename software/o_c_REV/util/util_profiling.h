@@ -38,6 +38,14 @@ public:
     return ARM_DWT_CYCCNT - start_;
   }
 
+  // Cycles since construction or the previous lap
+  uint32_t lap() {
+    uint32_t now = ARM_DWT_CYCCNT;
+    uint32_t cycles = now - start_;
+    start_ = now;
+    return cycles;
+  }
+
   static void Init() {
     ARM_DEMCR |= ARM_DEMCR_TRCENA;
     ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
@@ -85,9 +93,62 @@ struct AveragedCycles {
   }
 };
 
+// AveragedCycles plus a log2 histogram of all values pushed since Reset().
+// Bucket n counts values with n + kMinLog2 significant bits, so the first and
+// last buckets also collect anything shorter/longer. Counts saturate.
+struct HistogramCycles : public AveragedCycles {
+  static constexpr int kBuckets = 12;
+  static constexpr int kMinLog2 = 5;
+
+  HistogramCycles() : AveragedCycles() {
+    ClearHistogram();
+  }
+
+  uint16_t buckets_[kBuckets];
+
+  uint16_t bucket(int index) const {
+    return buckets_[index];
+  }
+
+  // Lower bound (in cycles) of values counted in bucket
+  static uint32_t bucket_floor(int index) {
+    return index ? 1UL << (index + kMinLog2 - 1) : 0;
+  }
+
+  static int bucket_index(uint32_t value) {
+    int bits = 32 - __builtin_clz(value | 1);
+    bits -= kMinLog2;
+    return bits < 0 ? 0 : (bits >= kBuckets ? kBuckets - 1 : bits);
+  }
+
+  void Reset() {
+    AveragedCycles::Reset();
+    ClearHistogram();
+  }
+
+  void ClearHistogram() {
+    for (auto &b : buckets_)
+      b = 0;
+  }
+
+  void push(uint32_t value) {
+    AveragedCycles::push(value);
+    uint16_t &b = buckets_[bucket_index(value)];
+    if (b < 0xffff) ++b;
+  }
+
+  uint32_t count() const {
+    uint32_t sum = 0;
+    for (auto b : buckets_)
+      sum += b;
+    return sum;
+  }
+};
+
+template <typename Dest>
 class ScopedCycleMeasurement {
 public:
-  ScopedCycleMeasurement(AveragedCycles &dest)
+  ScopedCycleMeasurement(Dest &dest)
   : dest_(dest)
   , cycles_() { }
 
@@ -96,7 +157,7 @@ public:
   }
 
 private:
-  AveragedCycles &dest_;
+  Dest &dest_;
   CycleMeasurement cycles_;
 };
 
@@ -0,0 +1,80 @@
+#ifndef UTIL_RANDOM_H_
+#define UTIL_RANDOM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+// Marsaglia's xorshift32: three shifts and xors per word, with a period of
+// 2^32 - 1. Bounded values scale the word by the range with a 32x32->64
+// multiply (a single umull on the M4) instead of Arduino random()'s division
+// and modulo; the bias is at most range / 2^32.
+//
+// Every state written is the successor of a nonzero state, so a generator
+// shared between the ISR and the main loop can at worst hand both the same
+// value when one preempts the other, but never gets stuck at zero.
+class Random {
+public:
+  static constexpr uint32_t kDefaultSeed = 0x21;
+
+  void Seed(uint32_t seed) {
+    if (!seed) seed = kDefaultSeed;
+    state_ = seed;
+  }
+
+  uint32_t state() const {
+    return state_;
+  }
+
+  uint32_t Next() {
+    uint32_t x = state_;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state_ = x;
+    return x;
+  }
+
+  // [0, range), or 0 if range is 0
+  uint32_t Below(uint32_t range) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(Next()) * range) >> 32);
+  }
+
+  // [min, max), or min if max <= min, like Arduino random(min, max)
+  int32_t Range(int32_t min, int32_t max) {
+    if (max <= min) return min;
+    return min + static_cast<int32_t>(Below(static_cast<uint32_t>(max - min)));
+  }
+
+  // Fills dst with values in [min, max)
+  void Fill(int16_t *dst, size_t length, int32_t min, int32_t max) {
+    const uint32_t range = max > min ? static_cast<uint32_t>(max - min) : 0;
+    uint32_t x = state_;
+    while (length--) {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      *dst++ = min + static_cast<int32_t>((static_cast<uint64_t>(x) * range) >> 32);
+    }
+    state_ = x;
+  }
+
+  // Spreads the bits of a value (the murmur3 finalizer), e.g. to derive
+  // unrelated seeds from consecutive ids
+  static uint32_t Mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85ebca6b;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35;
+    x ^= x >> 16;
+    return x;
+  }
+
+private:
+  uint32_t state_;
+};
+
+}; // namespace util
+
+#endif // UTIL_RANDOM_H_
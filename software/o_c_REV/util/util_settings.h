@@ -127,11 +127,18 @@ public:
     return (size_t)(write_ptr - static_cast<uint8_t *>(storage));
   }
 
-  size_t Restore(const void *storage) {
+  // With a length, only the settings that fit are restored, and the rest are left as they are. Since
+  // settings are stored in order, that reads the storage of an older version that had fewer of them.
+  size_t Restore(const void *storage, size_t length = storage_size_) {
     nibbles_ = 0;
     const uint8_t *read_ptr = static_cast<const uint8_t *>(storage);
+    const uint8_t *end = read_ptr + length;
     for (size_t s = 0; s < num_settings; ++s) {
-      switch(value_attr_[s].storage_type) {
+      const StorageType type = value_attr_[s].storage_type;
+      const size_t bytes = STORAGE_TYPE_U4 == type ? (nibbles_ ? 0 : 1) : storage_bytes(type);
+      if (read_ptr + bytes > end)
+        break;
+      switch(type) {
         case STORAGE_TYPE_U4: read_ptr = read_nibble(read_ptr, s); break;
         case STORAGE_TYPE_I8: read_ptr = read_setting<int8_t>(read_ptr, s); break;
         case STORAGE_TYPE_U8: read_ptr = read_setting<uint8_t>(read_ptr, s); break;
@@ -207,6 +214,18 @@ protected:
     return reinterpret_cast<const uint8_t *>(storage);
   }
 
+  static size_t storage_bytes(StorageType type) {
+    switch(type) {
+      case STORAGE_TYPE_I8: return sizeof(int8_t);
+      case STORAGE_TYPE_U8: return sizeof(uint8_t);
+      case STORAGE_TYPE_I16: return sizeof(int16_t);
+      case STORAGE_TYPE_U16: return sizeof(uint16_t);
+      case STORAGE_TYPE_I32: return sizeof(int32_t);
+      case STORAGE_TYPE_U32: return sizeof(uint32_t);
+      default: return 0;
+    }
+  }
+
   static size_t calc_storage_size() {
     size_t s = 0;
     unsigned nibbles = 0;
@@ -215,15 +234,7 @@ protected:
         ++nibbles;
       } else {
         if (nibbles & 1) ++nibbles;
-        switch(attr.storage_type) {
-          case STORAGE_TYPE_I8: s += sizeof(int8_t); break;
-          case STORAGE_TYPE_U8: s += sizeof(uint8_t); break;
-          case STORAGE_TYPE_I16: s += sizeof(int16_t); break;
-          case STORAGE_TYPE_U16: s += sizeof(uint16_t); break;
-          case STORAGE_TYPE_I32: s += sizeof(int32_t); break;
-          case STORAGE_TYPE_U32: s += sizeof(uint32_t); break;
-          default: break;
-        }
+        s += storage_bytes(attr.storage_type);
       }
     }
     if (nibbles & 1) ++nibbles;
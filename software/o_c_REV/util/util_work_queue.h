@@ -0,0 +1,72 @@
+#ifndef UTIL_WORK_QUEUE_H_
+#define UTIL_WORK_QUEUE_H_
+
+#include <stdint.h>
+#include "util_macros.h"
+#include "util_ringbuffer.h"
+
+namespace util {
+
+// Deferred work queue: lets an ISR hand commands to the main loop, so that
+// anything slow (parsing, unpacking, applying settings) happens outside of
+// the ISR.
+// - Single producer (ISR) / single consumer (loop), no locking required since
+//   only the producer moves the write head and only the consumer the read head
+// - Commands are copied in and out, so keep T small-ish and POD
+// - If the queue is full, Push fails and the command is counted as dropped;
+//   producers that can leave data pending (e.g. in the USB buffer) should
+//   check writable() first instead.
+//
+template <typename T, size_t size>
+class WorkQueue {
+public:
+  WorkQueue() { }
+
+  void Init() {
+    buffer_.Init();
+    dropped_ = 0;
+  }
+
+  inline bool writable() const {
+    return buffer_.writable() > 0;
+  }
+
+  inline size_t pending() const {
+    return buffer_.readable();
+  }
+
+  inline uint32_t dropped() const {
+    return dropped_;
+  }
+
+  inline bool Push(const T &command) {
+    if (!buffer_.writable()) {
+      ++dropped_;
+      return false;
+    }
+    buffer_.Write(command);
+    return true;
+  }
+
+  inline bool Pop(T &command) {
+    if (!buffer_.readable())
+      return false;
+    command = buffer_.Read();
+    return true;
+  }
+
+  inline void Flush() {
+    buffer_.Flush();
+  }
+
+private:
+
+  RingBuffer<T, size> buffer_;
+  volatile uint32_t dropped_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkQueue);
+};
+
+};
+
+#endif // UTIL_WORK_QUEUE_H_
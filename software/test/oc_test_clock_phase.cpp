@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "util/util_clock_phase.h"
+
+// The Hemisphere clock's rate: a 60us tick is a million ticks per minute
+static const uint32_t kTicksPerMinute = 1000000;
+static const uint32_t kTicksPerHour = 60 * kTicksPerMinute;
+
+typedef util::ClockPhase<kTicksPerMinute> TestClockPhase;
+
+// Runs the clock for an hour, and returns the largest difference in ticks
+// between a tock and its ideal time, given the tempo in 1/100 BPM. It can be
+// held off for the first few ticks of every thousand, as the ISR is.
+static double MaxTockError(uint32_t hundredths_bpm, uint32_t multiply, uint32_t *tocks, uint32_t held = 0)
+{
+  TestClockPhase phase;
+  phase.Init();
+  phase.SetRate(hundredths_bpm, multiply);
+
+  const double ticks_per_tock = 100.0 * kTicksPerMinute / (hundredths_bpm * multiply);
+  double max_error = 0;
+  *tocks = 0;
+  uint32_t last_tick = -1;
+  for (uint32_t tick = 0; tick < kTicksPerHour; ++tick) {
+    if (tick % 1000 < held) continue;
+    const uint32_t ticks = tick - last_tick;
+    last_tick = tick;
+    if (phase.Advance(ticks)) {
+      const double error = tick - *tocks * ticks_per_tock;
+      if (error > max_error) max_error = error;
+      if (-error > max_error) max_error = -error;
+      ++*tocks;
+    }
+  }
+  return max_error;
+}
+
+TEST(ClockPhase, DriftPerHour)
+{
+  // A tock happens in the first tick at or after its ideal time, so it's up
+  // to a tick late anywhere in the hour but never more. The old clock's
+  // rounding was worst at fast tempos, and any rounding of the increment
+  // would be worst at slow ones.
+  static const struct {
+    uint32_t hundredths_bpm;
+    uint32_t multiply;
+  } rates[] = {
+    {1000, 1}, {3333, 3}, {12000, 1}, {12857, 24}, {29999, 1}, {30000, 24}
+  };
+  for (auto rate : rates) {
+    uint32_t tocks;
+    EXPECT_LT(MaxTockError(rate.hundredths_bpm, rate.multiply, &tocks), 1.0)
+        << rate.hundredths_bpm << " x" << rate.multiply;
+    // Every tock whose ideal time is within the hour, including the one at 0
+    const uint32_t expected = (rate.hundredths_bpm * rate.multiply * 60 + 99) / 100;
+    EXPECT_EQ(expected, tocks) << rate.hundredths_bpm << " x" << rate.multiply;
+
+    // A tock in ticks that were held off comes in the first tick after, and
+    // the rest are where they'd be otherwise. Tocks are never closer together
+    // than 100 ticks here, so none are lost.
+    EXPECT_LT(MaxTockError(rate.hundredths_bpm, rate.multiply, &tocks, 100), 101.0)
+        << rate.hundredths_bpm << " x" << rate.multiply << " held";
+    EXPECT_EQ(expected, tocks) << rate.hundredths_bpm << " x" << rate.multiply << " held";
+  }
+}
+
+TEST(ClockPhase, SkippedTicks)
+{
+  // Held off for a run of ticks, the clock comes back in phase with one that
+  // wasn't, with one tock for any number of them that it missed
+  TestClockPhase phase, reference;
+  phase.Init();
+  reference.Init();
+  phase.SetRate(12000, 24);
+  reference.SetRate(12000, 24);
+  phase.SetSwing(60);
+  reference.SetSwing(60);
+
+  uint32_t tick = 0;
+  for (uint32_t held : {0U, 1U, 10U, 208U, 209U, 417U, 5000U, 1000000U}) {
+    bool missed = false;
+    for (uint32_t i = 0; i < held; ++i, ++tick) missed |= reference.Advance();
+    const bool tock = reference.Advance();
+    ++tick;
+    EXPECT_EQ(missed || tock, phase.Advance(held + 1)) << "held " << held;
+    EXPECT_EQ(reference.phase(), phase.phase()) << "held " << held;
+
+    for (uint32_t i = 0; i < 1000; ++i, ++tick) {
+      ASSERT_EQ(reference.Advance(), phase.Advance(1)) << "held " << held << " tick " << tick;
+    }
+  }
+}
+
+TEST(ClockPhase, EveryTempo)
+{
+  // Every tempo setting puts its first tocks in exactly the ticks of the ideal
+  // rate, so nothing is rounded that could add up over the hour
+  const uint32_t multiply = 24;
+  for (uint32_t tempo = 1000; tempo <= 30000; ++tempo) {
+    TestClockPhase phase;
+    phase.Init();
+    phase.SetRate(tempo, multiply);
+    uint64_t tocks = 0;
+    for (uint32_t tick = 0; tocks < 4; ++tick) {
+      if (phase.Advance()) {
+        const uint64_t ideal = (tocks * TestClockPhase::kTockPhase + tempo * multiply - 1) / (tempo * multiply);
+        ASSERT_EQ(ideal, tick) << tempo << " tock " << tocks;
+        ++tocks;
+      }
+    }
+  }
+}
+
+TEST(ClockPhase, Swing)
+{
+  // At 120 BPM x2 a pair of tocks is 8333.33 ticks
+  TestClockPhase phase;
+  phase.Init();
+  phase.SetRate(12000, 2);
+  phase.SetSwing(75);
+
+  uint32_t tock_ticks[5];
+  int tocks = 0;
+  for (uint32_t tick = 0; tick < 20000 && tocks < 5; ++tick) {
+    if (phase.Advance()) tock_ticks[tocks++] = tick;
+  }
+  ASSERT_EQ(5, tocks);
+  EXPECT_EQ(0U, tock_ticks[0]);
+  EXPECT_EQ(6250U, tock_ticks[1]);
+  EXPECT_EQ(8334U, tock_ticks[2]);
+  EXPECT_EQ(14584U, tock_ticks[3]);
+  EXPECT_EQ(16667U, tock_ticks[4]);
+
+  // Out of range swing is clamped
+  phase.SetSwing(99);
+  phase.Reset();
+  tocks = 0;
+  for (uint32_t tick = 0; tick < 8333 && tocks < 5; ++tick) {
+    if (phase.Advance()) tock_ticks[tocks++] = tick;
+  }
+  ASSERT_EQ(2, tocks);
+  EXPECT_EQ(6250U, tock_ticks[1]);
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "util/util_clock_pll.h"
+#include "util/util_random.h"
+
+static const uint32_t kMinPeriod = 100;
+static const uint32_t kMaxPeriod = 5000;
+static const double kJitterTicks = 1000.0 / 60;
+
+// MIDI clock as read from USB once per 60us tick: each pulse is up to 1ms
+// (16.7 ticks) late, at random
+class TestClockPll : public ::testing::Test {
+protected:
+  void SetUp() override {
+    pll.Init(kMinPeriod, kMaxPeriod);
+    random.Seed(1);
+    time = 1000.0;
+  }
+
+  // Sends pulses at bpm, and returns the first pulse after which the loop
+  // stayed locked, or -1. From pulse settled on, the estimated pulse times are
+  // checked against the ideal ones.
+  int Run(double bpm, int pulses, int settled = 48) {
+    const double period = 1000000.0 / (24 * bpm);
+    int locked_from = -1;
+    for (int n = 0; n < pulses; ++n) {
+      const double arrival = time + random.Below(1000) * kJitterTicks / 1000;
+      const uint32_t tick = static_cast<uint32_t>(arrival) + 1;
+      pll.Pulse(tick);
+      if (!pll.locked(tick)) locked_from = -1;
+      else if (locked_from < 0) locked_from = n;
+
+      // The estimates are within the jitter of the ideal times, plus half of
+      // its average delay
+      if (n >= settled) {
+        const double estimate = tick + pll.offset() / 65536.0;
+        EXPECT_NEAR(time + kJitterTicks / 2, estimate, kJitterTicks) << "pulse " << n;
+      }
+      time += period;
+    }
+    return locked_from;
+  }
+
+  double bpm() const {
+    return 1000000.0 * 65536 / (24.0 * pll.period());
+  }
+
+  util::ClockPll pll;
+  util::Random random;
+  double time;
+};
+
+TEST_F(TestClockPll, Lock)
+{
+  for (double tempo : {10.0, 97.25, 120.0, 300.0}) {
+    SetUp();
+    const int locked_from = Run(tempo, 24 * 8);
+    EXPECT_GE(locked_from, 0) << tempo;
+    EXPECT_LE(locked_from, 48) << tempo;
+    EXPECT_NEAR(tempo, bpm(), tempo * 0.002) << tempo;
+    EXPECT_TRUE(pll.running(static_cast<uint32_t>(time)));
+
+    // The average error is about a quarter of the USB jitter
+    EXPECT_GT(pll.jitter() / 65536.0, kJitterTicks / 8) << tempo;
+    EXPECT_LT(pll.jitter() / 65536.0, kJitterTicks / 2) << tempo;
+  }
+}
+
+TEST_F(TestClockPll, TempoChange)
+{
+  // It stays locked through a small change, and catches up within 2 beats
+  ASSERT_GE(Run(120.0, 24 * 4), 0);
+  EXPECT_EQ(0, Run(126.0, 24 * 8));
+  EXPECT_NEAR(126.0, bpm(), 0.25);
+
+  // A large one drops the lock
+  const int locked_from = Run(60.0, 24 * 8);
+  EXPECT_GT(locked_from, 0);
+  EXPECT_LE(locked_from, 48);
+  EXPECT_NEAR(60.0, bpm(), 0.12);
+}
+
+TEST_F(TestClockPll, Transport)
+{
+  ASSERT_GE(Run(120.0, 48), 0);
+  EXPECT_EQ(48U, pll.sequence());
+
+  pll.Stop();
+  EXPECT_FALSE(pll.running(static_cast<uint32_t>(time)));
+  pll.Start();
+  EXPECT_TRUE(pll.running(static_cast<uint32_t>(time)));
+  Run(120.0, 1);
+  EXPECT_EQ(0U, pll.index());
+  EXPECT_EQ(0, pll.offset());
+  EXPECT_TRUE(pll.locked(static_cast<uint32_t>(time)));
+
+  // No pulses for more than 4 periods
+  const uint32_t tick = static_cast<uint32_t>(time + 4 * 347.3);
+  EXPECT_FALSE(pll.running(tick));
+  EXPECT_FALSE(pll.locked(tick));
+}
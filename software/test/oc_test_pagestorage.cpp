@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+#include <string.h>
+#include "util/util_pagestorage.h"
+
+struct TestStorage {
+  static const size_t LENGTH = 256;
+
+  static uint8_t data[LENGTH];
+  static size_t reads;
+  static size_t writes;
+
+  static void update(size_t addr, const void *src, size_t length) {
+    const uint8_t *p = (const uint8_t *)src;
+    for (size_t i = 0; i < length; ++i) {
+      if (data[addr + i] != p[i]) {
+        data[addr + i] = p[i];
+        ++writes;
+      }
+    }
+  }
+
+  static void write(size_t addr, const void *src, size_t length) {
+    memcpy(data + addr, src, length);
+    writes += length;
+  }
+
+  static void read(size_t addr, void *dst, size_t length) {
+    memcpy(dst, data + addr, length);
+    reads += length;
+  }
+};
+
+uint8_t TestStorage::data[TestStorage::LENGTH];
+size_t TestStorage::reads;
+size_t TestStorage::writes;
+
+struct TestData {
+  static constexpr uint32_t FOURCC = FOURCC<'T','E','S','T'>::value;
+  uint8_t values[40];
+};
+
+typedef PageStorage<TestStorage, 0, TestStorage::LENGTH, TestData> TestPageStorage;
+typedef PageStorage<TestStorage, 0, TestStorage::LENGTH, TestData, STORAGE_UPDATE, false> TestPageStorageScan;
+
+class TestPageStorageFixture : public ::testing::Test {
+protected:
+  void SetUp() override {
+    memset(TestStorage::data, 0xff, sizeof(TestStorage::data));
+    TestStorage::writes = 0;
+  }
+};
+
+TEST_F(TestPageStorageFixture, SaveStep)
+{
+  TestPageStorage storage;
+  TestData data;
+  EXPECT_FALSE(storage.Load(data));
+
+  memset(&data, 0x5a, sizeof(data));
+  EXPECT_TRUE(storage.Save(data));
+  EXPECT_EQ(0, storage.page_index());
+
+  // Unchanged data isn't saved
+  TestStorage::writes = 0;
+  EXPECT_FALSE(storage.BeginSave(data));
+  EXPECT_EQ(0U, storage.save_remaining());
+
+  // Steps write at most the given number of bytes, and the page doesn't load
+  // until it's complete
+  data.values[3] = 0x12;
+  data.values[30] = 0x34;
+  EXPECT_TRUE(storage.BeginSave(data));
+  const size_t page_size = TestPageStorage::PAGESIZE;
+  EXPECT_EQ(page_size, storage.save_remaining());
+  EXPECT_EQ(1, storage.page_index());
+  data.values[3] = 0; // Save is of a copy
+
+  size_t steps = 0;
+  while (storage.SaveStep(4)) {
+    EXPECT_LE(TestStorage::writes, (steps + 1) * 4);
+    TestData loaded;
+    TestPageStorage reader;
+    ASSERT_TRUE(reader.Load(loaded));
+    EXPECT_EQ(0, reader.page_index());
+    ++steps;
+  }
+  EXPECT_EQ(0U, storage.save_remaining());
+
+  TestData loaded;
+  TestPageStorage reader;
+  ASSERT_TRUE(reader.Load(loaded));
+  EXPECT_EQ(1, reader.page_index());
+  EXPECT_EQ(0x12, loaded.values[3]);
+  EXPECT_EQ(0x34, loaded.values[30]);
+  EXPECT_EQ(0x5a, loaded.values[4]);
+}
+
+TEST_F(TestPageStorageFixture, SaveRestart)
+{
+  TestPageStorage storage;
+  TestData data;
+  storage.Init();
+
+  memset(&data, 0, sizeof(data));
+  EXPECT_TRUE(storage.BeginSave(data));
+  storage.SaveStep(8);
+
+  // Saving while pending goes to the same page with the newer data
+  data.values[0] = 1;
+  EXPECT_TRUE(storage.BeginSave(data));
+  EXPECT_EQ(0, storage.page_index());
+  while (storage.SaveStep(8)) { }
+
+  TestData loaded;
+  TestPageStorage reader;
+  ASSERT_TRUE(reader.Load(loaded));
+  EXPECT_EQ(0, reader.page_index());
+  EXPECT_EQ(1, loaded.values[0]);
+}
+
+TEST_F(TestPageStorageFixture, LoadNewest)
+{
+  const size_t pages = TestPageStorage::PAGES;
+  const size_t page_size = TestPageStorage::PAGESIZE;
+  ASSERT_GE(pages, 4U);
+
+  TestPageStorage storage;
+  TestData data;
+  EXPECT_FALSE(storage.Load(data));
+  memset(&data, 0, sizeof(data));
+
+  // Every page count from empty to wrapped around twice
+  for (size_t saves = 1; saves < 2 * pages + 2; ++saves) {
+    data.values[0] = saves;
+    ASSERT_TRUE(storage.Save(data));
+
+    TestData loaded;
+    TestPageStorage reader;
+    TestStorage::reads = 0;
+    ASSERT_TRUE(reader.Load(loaded));
+    EXPECT_EQ(storage.page_index(), reader.page_index());
+    EXPECT_EQ(saves, loaded.values[0]);
+    EXPECT_LT(TestStorage::reads, 2 * page_size);
+
+    TestPageStorageScan scanner;
+    ASSERT_TRUE(scanner.Load(loaded));
+    EXPECT_EQ(storage.page_index(), scanner.page_index());
+  }
+
+  // A newest page with a bad checksum falls back to the previous one
+  const int newest = storage.page_index();
+  TestStorage::data[newest * page_size + page_size - 1] ^= 0xff;
+  TestData loaded;
+  TestPageStorage reader;
+  ASSERT_TRUE(reader.Load(loaded));
+  EXPECT_EQ((newest + pages - 1) % pages, (size_t)reader.page_index());
+}
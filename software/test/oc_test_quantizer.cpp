@@ -39,3 +39,27 @@ TEST_F(QuantizerTest, SingleNote) {
   EXPECT_EQ(0, quantizer_.Process(-128));
   EXPECT_EQ(0, quantizer_.Process(-kOctave/2));
 }
+
+TEST(QuantizerTableTest, SameAsSearch) {
+  static const uint16_t masks[] = { 0xffff, 0x1, 0x5, 0xa5a, 0x8001 };
+  braids::QuantizerTable table;
+
+  for (const braids::Scale &scale : braids::scales) {
+    for (uint16_t mask : masks) {
+      braids::Quantizer search, lookup;
+      search.Init();
+      lookup.Init();
+      lookup.EnableTable(table);
+      search.Configure(scale, mask);
+      lookup.Configure(scale, mask);
+      search.Requantize();
+      lookup.Requantize();
+
+      for (int32_t pitch = -16384; pitch <= 16384; ++pitch) {
+        int32_t transpose = (pitch & 0x300) >> 8;
+        ASSERT_EQ(search.Process(pitch, 0, transpose), lookup.Process(pitch, 0, transpose))
+          << "span " << scale.span << " mask " << mask << " pitch " << pitch;
+      }
+    }
+  }
+}
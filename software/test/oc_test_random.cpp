@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+#include "util/util_random.h"
+
+TEST(TestRandom, Ranges)
+{
+  util::Random random;
+  random.Seed(0);
+  EXPECT_EQ(static_cast<uint32_t>(util::Random::kDefaultSeed), random.state());
+
+  int histogram[10] = { 0 };
+  for (int i = 0; i < 100000; ++i) {
+    int32_t value = random.Range(-5, 5);
+    ASSERT_GE(value, -5);
+    ASSERT_LT(value, 5);
+    ++histogram[value + 5];
+  }
+  // Roughly uniform
+  for (int count : histogram) {
+    EXPECT_GT(count, 9000);
+    EXPECT_LT(count, 11000);
+  }
+
+  // Empty ranges, like Arduino random()
+  EXPECT_EQ(7, random.Range(7, 7));
+  EXPECT_EQ(7, random.Range(7, 3));
+  EXPECT_EQ(0U, random.Below(0));
+  EXPECT_NE(0U, random.state());
+}
+
+TEST(TestRandom, Fill)
+{
+  util::Random a, b;
+  a.Seed(1234);
+  b.Seed(1234);
+
+  int16_t block[13];
+  a.Fill(block, 13, -4608, 4608);
+  for (int16_t value : block)
+    EXPECT_EQ(b.Range(-4608, 4608), value);
+  EXPECT_EQ(a.state(), b.state());
+}
+
+TEST(TestRandom, Mix)
+{
+  // Neighbouring ids give unrelated seeds
+  EXPECT_NE(util::Random::Mix(1), util::Random::Mix(2));
+  EXPECT_NE(util::Random::Mix(1) & 0xffff, util::Random::Mix(2) & 0xffff);
+  EXPECT_NE(util::Random::Mix(1) >> 16, util::Random::Mix(2) >> 16);
+}
@@ -107,3 +107,80 @@ TEST(TestSettings,TestPackU4OddEnd)
   EXPECT_EQ(-1, settings.get_value(0));
   EXPECT_EQ(0x09, settings.get_value(1));
 }
+
+class TestRestoreLengthSettings : public settings::SettingsBase<TestRestoreLengthSettings, 4> { };
+SETTINGS_DECLARE(TestRestoreLengthSettings, 4) {
+  { 0, 0, 255, "U8", nullptr, settings::STORAGE_TYPE_U8 },
+  { 0, 0, 65535, "U16", nullptr, settings::STORAGE_TYPE_U16 },
+  { 1, 0, 15, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+  { 2, 0, 15, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+};
+
+TEST(TestSettings,TestRestoreLength)
+{
+  EXPECT_EQ(4, TestRestoreLengthSettings::storageSize());
+
+  TestRestoreLengthSettings settings;
+  settings.InitDefaults();
+  EXPECT_TRUE(settings.apply_value(0, 200));
+  EXPECT_TRUE(settings.apply_value(1, 50000));
+  EXPECT_TRUE(settings.apply_value(2, 0x09));
+  EXPECT_TRUE(settings.apply_value(3, 0x06));
+
+  std::vector<uint8_t> data;
+  data.resize(TestRestoreLengthSettings::storageSize(), 0xff);
+  settings.Save(&data.front());
+
+  // As saved by an older version with only the first two settings
+  settings.InitDefaults();
+  EXPECT_EQ(3U, settings.Restore(&data.front(), 3));
+  EXPECT_EQ(200, settings.get_value(0));
+  EXPECT_EQ(50000, settings.get_value(1));
+  EXPECT_EQ(1, settings.get_value(2));
+  EXPECT_EQ(2, settings.get_value(3));
+
+  // Both nibbles are in the last byte
+  settings.InitDefaults();
+  EXPECT_EQ(4U, settings.Restore(&data.front(), 4));
+  EXPECT_EQ(0x09, settings.get_value(2));
+  EXPECT_EQ(0x06, settings.get_value(3));
+}
+
+// The Hemisphere clock's data, as in HEM_ClockSetup and APP_HEMISPHERE: 32 bits in a single U16
+// setting, and split between two
+class TestClockDataSettings : public settings::SettingsBase<TestClockDataSettings, 3> { };
+SETTINGS_DECLARE(TestClockDataSettings, 3) {
+  { 0, 0, 65535, "Clock data", nullptr, settings::STORAGE_TYPE_U16 },
+  { 0, 0, 255, "Preset ID", nullptr, settings::STORAGE_TYPE_U8 },
+  { 0, 0, 65535, "Clock data high", nullptr, settings::STORAGE_TYPE_U16 },
+};
+
+static uint32_t ClockData(uint32_t running, uint32_t tempo, uint32_t multiply, uint32_t hundredths, uint32_t swing,
+                          uint32_t midi_sync)
+{
+  return running | (tempo << 1) | (multiply << 10) | (hundredths << 15) | (swing << 22) | (midi_sync << 27);
+}
+
+TEST(TestSettings,TestClockData)
+{
+  TestClockDataSettings settings;
+  const uint32_t data = ClockData(1, 300, 24, 99, 75 - 50, 1);
+
+  // The hundredths, swing and MIDI sync don't fit in one setting
+  settings.InitDefaults();
+  settings.apply_value(0, data);
+  EXPECT_NE(data, static_cast<uint32_t>(settings.get_value(0)));
+
+  for (uint32_t expected : {data, ClockData(0, 10, 1, 0, 0, 0), ClockData(1, 120, 4, 1, 1, 0),
+                            ClockData(0, 120, 1, 0, 0, 1)}) {
+    settings.InitDefaults();
+    settings.apply_value(0, expected & 0xffff);
+    settings.apply_value(2, (expected >> 16) & 0xffff);
+
+    std::vector<uint8_t> storage(TestClockDataSettings::storageSize());
+    settings.Save(&storage.front());
+    settings.InitDefaults();
+    settings.Restore(&storage.front());
+    EXPECT_EQ(expected, (static_cast<uint32_t>(settings.get_value(2)) << 16) + settings.get_value(0));
+  }
+}